@@ -51,6 +51,14 @@ namespace v1
 
         ~Point() noexcept = default;
 
+        constexpr auto
+        X() const noexcept -> int
+        { return x; }
+
+        constexpr auto
+        Y() const noexcept -> int
+        { return y; }
+
         constexpr auto
         operator+ (const Point& p) noexcept -> Point
         { return Point{ x + p.x, y + p.y }; }
@@ -0,0 +1,59 @@
+#pragma once  ///< ignore this
+
+#include <ostream>
+#include <type_traits>
+
+namespace v4
+{
+    /// Same interface as `v1::Point`, but every special member is left to
+    /// the compiler (rule of zero). That keeps value semantics while making
+    /// `Point` trivial, so containers relocate points with `memcpy` and loops
+    /// over arrays of points can be vectorised. As with `v1::Point`, a
+    /// default constructed `Point` is uninitialised.
+    class Point
+    {
+    public:
+        constexpr Point() = default;
+
+        explicit constexpr
+        Point(int x, int y) noexcept
+            : x{ x }, y{ y }
+        { }
+
+        constexpr auto
+        X() const noexcept -> int
+        { return x; }
+
+        constexpr auto
+        Y() const noexcept -> int
+        { return y; }
+
+        constexpr auto
+        operator+ (const Point& p) const noexcept -> Point
+        { return Point{ x + p.x, y + p.y }; }
+
+        constexpr auto
+        operator- (const Point& p) const noexcept -> Point
+        { return Point{ x - p.x, y - p.y }; }
+
+        constexpr auto
+        operator== (const Point& p) const noexcept -> bool = default;
+
+        friend auto
+        operator<< (std::ostream& os, const Point& p)
+            noexcept -> std::ostream&
+        { 
+            os << "( " << p.x << ", " << p.y << " )";
+            return os;
+        }
+
+    private:
+        int x;
+        int y;
+
+    };  /// class Point
+
+    static_assert(std::is_trivial_v<Point>);
+    static_assert(sizeof(Point) == 2 * sizeof(int));
+
+}  /// namespace v4
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+/// Axis-aligned box with inclusive bounds.
+struct point_box
+{
+    int min_x { std::numeric_limits<int>::max() };
+    int min_y { std::numeric_limits<int>::max() };
+    int max_x { std::numeric_limits<int>::min() };
+    int max_y { std::numeric_limits<int>::min() };
+
+    constexpr auto
+    empty() const noexcept -> bool
+    { return min_x > max_x; }
+
+    constexpr auto
+    contains(int x, int y) const noexcept -> bool
+    { return min_x <= x && x <= max_x && min_y <= y && y <= max_y; }
+
+    constexpr auto
+    contains(const point_box& b) const noexcept -> bool
+    { return min_x <= b.min_x && b.max_x <= max_x && min_y <= b.min_y && b.max_y <= max_y; }
+
+    constexpr auto
+    intersects(const point_box& b) const noexcept -> bool
+    { return min_x <= b.max_x && b.min_x <= max_x && min_y <= b.max_y && b.min_y <= max_y; }
+
+    constexpr auto
+    expand(int x, int y) noexcept -> void
+    {
+        min_x = std::min(min_x, x);
+        min_y = std::min(min_y, y);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+    }
+
+    constexpr auto
+    expand(const point_box& b) noexcept -> void
+    {
+        min_x = std::min(min_x, b.min_x);
+        min_y = std::min(min_y, b.min_y);
+        max_x = std::max(max_x, b.max_x);
+        max_y = std::max(max_y, b.max_y);
+    }
+
+    /// Squared distance from (x, y) to the closest point of the box.
+    constexpr auto
+    distance2(int x, int y) const noexcept -> std::int64_t
+    {
+        auto dx = std::max({ std::int64_t{ min_x } - x, std::int64_t{ 0 }, std::int64_t{ x } - max_x });
+        auto dy = std::max({ std::int64_t{ min_y } - y, std::int64_t{ 0 }, std::int64_t{ y } - max_y });
+        return dx * dx + dy * dy;
+    }
+};
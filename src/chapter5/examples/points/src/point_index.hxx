@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../../point-v1.hxx"
+#include "point_box.hxx"
+#include "space_filling_curve.hxx"
+
+/// Static spatial index over `v1::Point`s for range and k-nearest-neighbour
+/// queries.
+///
+/// Points are sorted along a Morton (Z-order) curve, so points that are close
+/// in the plane are mostly close in memory, and cut into fixed-size leaves
+/// of `leaf_size` consecutive points. Because of the curve the leaves are
+/// spatially compact, and a complete binary tree of bounding boxes over them
+/// (stored implicitly in one array, children of `i` at `2i + 1` and `2i + 2`)
+/// prunes whole regions during a query. Coordinates are kept as separate x
+/// and y arrays so the scan of a leaf touches only what it needs.
+///
+/// Construction computes keys, sorts and builds leaf boxes with the parallel
+/// algorithms. Queries return indices into the array the index was built
+/// from. The batched queries run many queries in parallel.
+class point_index
+{
+public:
+
+    using size_type = std::size_t;
+    using id_type   = std::uint32_t;
+
+    static constexpr size_type leaf_size = 32;
+
+    point_index() = default;
+
+    explicit
+    point_index(std::span<const v1::Point> points)
+    {
+        if (points.size() > std::numeric_limits<id_type>::max())
+            throw std::length_error("Too Many Points");
+
+        auto n = points.size();
+        auto keyed = std::vector<std::pair<std::uint64_t, id_type>>(n);
+        /// The parallel algorithms only split random access ranges they can
+        /// hand out by iterator, so the positions go in a real vector rather
+        /// than a `std::views::iota`, which would run serially.
+        auto ids = std::vector<size_type>(n);
+        std::iota(ids.begin(), ids.end(), size_type{ 0 });
+        std::for_each(std::execution::par_unseq, ids.begin(), ids.end(), [&](size_type i)
+        { keyed[i] = { morton_code(to_curve_coord(points[i].X()), to_curve_coord(points[i].Y())), static_cast<id_type>(i) }; });
+
+        std::sort(std::execution::par_unseq, keyed.begin(), keyed.end());
+
+        m_xs.resize(n);
+        m_ys.resize(n);
+        m_ids.resize(n);
+        std::for_each(std::execution::par_unseq, ids.begin(), ids.end(), [&](size_type i)
+        {
+            auto id = keyed[i].second;
+            m_xs[i] = points[id].X();
+            m_ys[i] = points[id].Y();
+            m_ids[i] = id;
+        });
+
+        _M_build_tree();
+    }
+
+    auto
+    size() const noexcept -> size_type
+    { return m_ids.size(); }
+
+    auto
+    bounds() const noexcept -> point_box
+    { return m_nodes.empty() ? point_box{} : m_nodes.front(); }
+
+    /// Appends the index of every point inside `box` to `out`.
+    auto
+    range(const point_box& box, std::vector<id_type>& out) const -> void
+    {
+        if (m_nodes.empty() || !m_nodes.front().intersects(box))
+            return;
+
+        auto stack = std::array<size_type, 64>{};
+        auto top = size_type{ 0 };
+        stack[top++] = 0;
+
+        while (top)
+        {
+            auto node = stack[--top];
+            const auto& b = m_nodes[node];
+
+            if (box.contains(b))
+            {
+                auto [first, last] = _M_span(node);
+                out.insert(out.end(), m_ids.begin() + first, m_ids.begin() + last);
+            }
+            else if (node >= m_first_leaf)
+            {
+                auto [first, last] = _M_span(node);
+                for (auto i = first; i < last; ++i)
+                    if (box.contains(m_xs[i], m_ys[i]))
+                        out.push_back(m_ids[i]);
+            }
+            else
+            {
+                for (auto child : { 2 * node + 1, 2 * node + 2 })
+                    if (m_nodes[child].intersects(box))
+                        stack[top++] = child;
+            }
+        }
+    }
+
+    /// Indices of the `k` points nearest `q`, nearest first. Ties are broken
+    /// arbitrarily.
+    auto
+    nearest(const v1::Point& q, size_type k) const -> std::vector<id_type>
+    {
+        auto out = std::vector<id_type>{};
+        nearest(q, k, out);
+        return out;
+    }
+
+    auto
+    nearest(const v1::Point& q, size_type k, std::vector<id_type>& out) const -> void
+    {
+        out.clear();
+        if (k == 0 || m_nodes.empty())
+            return;
+
+        auto qx = q.X();
+        auto qy = q.Y();
+
+        /// Max-heap of the best `k` so far, so the worst is on top.
+        using candidate = std::pair<std::int64_t, id_type>;
+        auto best = std::priority_queue<candidate>{};
+
+        auto stack = std::array<size_type, 64>{};
+        auto top = size_type{ 0 };
+        stack[top++] = 0;
+
+        while (top)
+        {
+            auto node = stack[--top];
+            if (best.size() == k && m_nodes[node].distance2(qx, qy) >= best.top().first)
+                continue;
+
+            if (node >= m_first_leaf)
+            {
+                auto [first, last] = _M_span(node);
+                for (auto i = first; i < last; ++i)
+                {
+                    auto dx = std::int64_t{ m_xs[i] } - qx;
+                    auto dy = std::int64_t{ m_ys[i] } - qy;
+                    auto d = dx * dx + dy * dy;
+                    if (best.size() < k)
+                        best.emplace(d, m_ids[i]);
+                    else if (d < best.top().first)
+                    {
+                        best.pop();
+                        best.emplace(d, m_ids[i]);
+                    }
+                }
+            }
+            else
+            {
+                /// Push the farther child first so the nearer one is searched
+                /// first and tightens the bound sooner.
+                auto l = 2 * node + 1;
+                auto r = 2 * node + 2;
+                if (m_nodes[l].distance2(qx, qy) < m_nodes[r].distance2(qx, qy))
+                    std::swap(l, r);
+                for (auto child : { l, r })
+                    if (!m_nodes[child].empty())
+                        stack[top++] = child;
+            }
+        }
+
+        out.resize(best.size());
+        for (auto i = out.size(); i-- > 0; best.pop())
+            out[i] = best.top().second;
+    }
+
+    /// Runs every range query in parallel; `out[i]` receives the result of
+    /// `boxes[i]`.
+    auto
+    range_batch(std::span<const point_box> boxes) const -> std::vector<std::vector<id_type>>
+    {
+        auto out = std::vector<std::vector<id_type>>(boxes.size());
+        auto qs = std::vector<size_type>(boxes.size());
+        std::iota(qs.begin(), qs.end(), size_type{ 0 });
+        std::for_each(std::execution::par, qs.begin(), qs.end(), [&](size_type i)
+        { range(boxes[i], out[i]); });
+        return out;
+    }
+
+    /// Runs every kNN query in parallel. The result is flattened: the
+    /// neighbours of `queries[i]` are `out[i * k, i * k + k)`, padded with
+    /// `no_point` when the index has fewer than `k` points.
+    auto
+    nearest_batch(std::span<const v1::Point> queries, size_type k) const -> std::vector<id_type>
+    {
+        auto out = std::vector<id_type>(queries.size() * k, no_point);
+        auto qs = std::vector<size_type>(queries.size());
+        std::iota(qs.begin(), qs.end(), size_type{ 0 });
+        std::for_each(std::execution::par, qs.begin(), qs.end(), [&](size_type i)
+        {
+            thread_local auto scratch = std::vector<id_type>{};
+            nearest(queries[i], k, scratch);
+            std::ranges::copy(scratch, out.begin() + static_cast<std::ptrdiff_t>(i * k));
+        });
+        return out;
+    }
+
+    static constexpr id_type no_point = std::numeric_limits<id_type>::max();
+
+private:
+
+    /// Range of sorted positions covered by `node`.
+    auto
+    _M_span(size_type node) const noexcept -> std::pair<size_type, size_type>
+    {
+        /// Walk down to the leftmost and rightmost leaves under `node`.
+        auto lo = node;
+        auto hi = node;
+        while (lo < m_first_leaf)
+        {
+            lo = 2 * lo + 1;
+            hi = 2 * hi + 2;
+        }
+
+        auto first = (lo - m_first_leaf) * leaf_size;
+        auto last = (hi - m_first_leaf + 1) * leaf_size;
+        return { std::min(first, size()), std::min(last, size()) };
+    }
+
+    auto
+    _M_build_tree() -> void
+    {
+        auto n = size();
+        if (n == 0)
+            return;
+
+        auto leaves = (n + leaf_size - 1) / leaf_size;
+        auto width = std::bit_ceil(leaves);
+        m_first_leaf = width - 1;
+        m_nodes.assign(2 * width - 1, point_box{});
+
+        auto ls = std::vector<size_type>(leaves);
+        std::iota(ls.begin(), ls.end(), size_type{ 0 });
+        std::for_each(std::execution::par_unseq, ls.begin(), ls.end(), [&](size_type l)
+        {
+            auto& b = m_nodes[m_first_leaf + l];
+            auto last = std::min(n, (l + 1) * leaf_size);
+            for (auto i = l * leaf_size; i < last; ++i)
+                b.expand(m_xs[i], m_ys[i]);
+        });
+
+        for (auto node = m_first_leaf; node-- > 0; )
+        {
+            m_nodes[node] = m_nodes[2 * node + 1];
+            m_nodes[node].expand(m_nodes[2 * node + 2]);
+        }
+    }
+
+    std::vector<int> m_xs;
+    std::vector<int> m_ys;
+    std::vector<id_type> m_ids;
+    std::vector<point_box> m_nodes;
+    size_type m_first_leaf { 0 };
+};
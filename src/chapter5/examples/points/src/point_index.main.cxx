@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../point-v1.hxx"
+#include "point_index.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args) 
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+using id_type = point_index::id_type;
+
+constexpr auto extent          = 1'000'000;
+constexpr auto queries         = std::size_t{ 10'000 };
+constexpr auto k               = std::size_t{ 8 };
+constexpr auto points_per_box  = 100.0;
+
+auto brute_range(const std::vector<v1::Point>& points, const point_box& box) -> std::vector<id_type>
+{
+    auto out = std::vector<id_type>{};
+    for (auto i = std::size_t{ 0 }; i < points.size(); ++i)
+        if (box.contains(points[i].X(), points[i].Y()))
+            out.push_back(static_cast<id_type>(i));
+    return out;
+}
+
+auto distance2(const v1::Point& a, const v1::Point& b) -> std::int64_t
+{
+    auto dx = std::int64_t{ a.X() } - b.X();
+    auto dy = std::int64_t{ a.Y() } - b.Y();
+    return dx * dx + dy * dy;
+}
+
+/// Squared distances of the `k` nearest points, ascending.
+auto brute_nearest(const std::vector<v1::Point>& points, const v1::Point& q) -> std::vector<std::int64_t>
+{
+    auto best = std::vector<std::int64_t>{};
+    for (const auto& p : points)
+    {
+        auto d = distance2(p, q);
+        if (best.size() < k)
+            best.insert(std::ranges::upper_bound(best, d), d);
+        else if (d < best.back())
+        {
+            best.pop_back();
+            best.insert(std::ranges::upper_bound(best, d), d);
+        }
+    }
+    return best;
+}
+
+auto print(std::size_t n, const std::string& query, double brute_us, double index_us, double batch_us, bool ok) -> void
+{
+    std::cout << "| " << std::setw(11) << n << " | " << std::setw(5) << query << " | "
+              << std::setw(12) << brute_us << " | " << std::setw(10) << index_us << " | "
+              << std::setw(10) << batch_us << " | " << std::setw(9) << brute_us / index_us << "x | "
+              << std::setw(5) << (ok ? "yes" : "NO") << " |" << std::endl;
+}
+
+/// Usage: ./point_index [max points, default 10^7]
+auto main(int argc, char* argv[]) -> int
+{
+    auto max_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000ull;
+    auto gen = std::mt19937{ 42 };
+    auto coord = std::uniform_int_distribution<int>{ 0, extent - 1 };
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Range boxes hold ~" << points_per_box << " points; kNN with k = " << k << ". Times are us per query.\n";
+    std::cout << "+-------------+-------+--------------+------------+------------+------------+-------+" << std::endl;
+    std::cout << "|   Points    | Query |  Brute force |   Index    |   Batch    |  Speedup   |  Same |" << std::endl;
+    std::cout << "+-------------+-------+--------------+------------+------------+------------+-------+" << std::endl;
+
+    for (auto n = std::size_t{ 10'000 }; n <= max_points; n *= 10)
+    {
+        auto points = std::vector<v1::Point>{};
+        points.reserve(n);
+        for (auto i = std::size_t{ 0 }; i < n; ++i)
+            points.emplace_back(coord(gen), coord(gen));
+
+        auto [build_us, index] = measure<>::execution([&]() { return point_index{ points }; });
+
+        auto side = static_cast<int>(extent * std::sqrt(points_per_box / static_cast<double>(n)));
+        auto boxes = std::vector<point_box>{};
+        auto probes = std::vector<v1::Point>{};
+        for (auto q = std::size_t{ 0 }; q < queries; ++q)
+        {
+            auto x = coord(gen);
+            auto y = coord(gen);
+            boxes.push_back(point_box{ x, y, x + side, y + side });
+            probes.emplace_back(coord(gen), coord(gen));
+        }
+
+        /// Brute force is O(n) per query, so it only runs a sample.
+        auto brute_queries = std::clamp(std::size_t{ 100'000'000 } / n, std::size_t{ 10 }, queries);
+
+        {
+            auto [brute_t, brute] = measure<>::execution([&]()
+            {
+                auto out = std::vector<std::vector<id_type>>{};
+                for (auto q = std::size_t{ 0 }; q < brute_queries; ++q)
+                    out.push_back(brute_range(points, boxes[q]));
+                return out;
+            });
+
+            auto [index_t, found] = measure<>::execution([&]()
+            {
+                auto out = std::vector<std::vector<id_type>>(queries);
+                for (auto q = std::size_t{ 0 }; q < queries; ++q)
+                    index.range(boxes[q], out[q]);
+                return out;
+            });
+
+            auto [batch_t, batched] = measure<>::execution([&]() { return index.range_batch(boxes); });
+
+            auto ok = true;
+            for (auto q = std::size_t{ 0 }; q < brute_queries; ++q)
+            {
+                std::ranges::sort(found[q]);
+                std::ranges::sort(batched[q]);
+                ok = ok && found[q] == brute[q] && batched[q] == brute[q];
+            }
+
+            print(n, "range", static_cast<double>(brute_t) / brute_queries, static_cast<double>(index_t) / queries,
+                  static_cast<double>(batch_t) / queries, ok);
+        }
+
+        {
+            auto [brute_t, brute] = measure<>::execution([&]()
+            {
+                auto out = std::vector<std::vector<std::int64_t>>{};
+                for (auto q = std::size_t{ 0 }; q < brute_queries; ++q)
+                    out.push_back(brute_nearest(points, probes[q]));
+                return out;
+            });
+
+            auto [index_t, found] = measure<>::execution([&]()
+            {
+                auto out = std::vector<std::vector<id_type>>(queries);
+                for (auto q = std::size_t{ 0 }; q < queries; ++q)
+                    index.nearest(probes[q], k, out[q]);
+                return out;
+            });
+
+            auto [batch_t, batched] = measure<>::execution([&]() { return index.nearest_batch(probes, k); });
+
+            /// Compare distances, since equidistant neighbours may differ.
+            auto ok = true;
+            for (auto q = std::size_t{ 0 }; q < brute_queries; ++q)
+                for (auto j = std::size_t{ 0 }; j < k; ++j)
+                    ok = ok && distance2(points[found[q][j]], probes[q]) == brute[q][j]
+                            && distance2(points[batched[q * k + j]], probes[q]) == brute[q][j];
+
+            print(n, "kNN", static_cast<double>(brute_t) / brute_queries, static_cast<double>(index_t) / queries,
+                  static_cast<double>(batch_t) / queries, ok);
+        }
+
+        std::cout << "| " << std::setw(11) << n << " | build | " << std::setw(12) << build_us / 1000.0
+                  << " ms                                             |" << std::endl;
+        std::cout << "+-------------+-------+--------------+------------+------------+------------+-------+" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "point_box.hxx"
+
+/// Any `Point` version with `X()`/`Y()` accessors and an `(x, y)`
+/// constructor.
+template <typename P>
+concept planar_point = requires (const P& p)
+{
+    { p.X() } -> std::convertible_to<int>;
+    { p.Y() } -> std::convertible_to<int>;
+    P{ 0, 0 };
+};
+
+/// Coordinate sums, widened so large arrays don't overflow.
+struct point_sum
+{
+    std::int64_t x { 0 };
+    std::int64_t y { 0 };
+};
+
+/// Batch kernels over arrays of points.
+///
+/// Each is a single pass with plain accumulators and no data-dependent
+/// branches, which is the shape the auto-vectoriser needs. Whether it
+/// actually vectorises depends on the point type: with a trivially copyable
+/// `Point` (such as `v4::Point`) every element is just two `int`s and the
+/// loops become SIMD adds, min/max and widening sums; with a `Point` whose
+/// copy and assignment are user-provided (such as `v1::Point`) the compiler
+/// has to run them element by element.
+
+/// Adds `(dx, dy)` to every point.
+template <planar_point P>
+auto translate(std::span<P> points, int dx, int dy) noexcept -> void
+{
+    for (auto i = std::size_t{ 0 }; i < points.size(); ++i)
+        points[i] = P{ points[i].X() + dx, points[i].Y() + dy };
+}
+
+template <planar_point P>
+auto sum(std::span<const P> points) noexcept -> point_sum
+{
+    auto sx = std::int64_t{ 0 };
+    auto sy = std::int64_t{ 0 };
+    for (auto i = std::size_t{ 0 }; i < points.size(); ++i)
+    {
+        sx += points[i].X();
+        sy += points[i].Y();
+    }
+    return point_sum{ sx, sy };
+}
+
+/// Smallest box containing every point; empty for an empty array.
+template <planar_point P>
+auto bounding_box(std::span<const P> points) noexcept -> point_box
+{
+    auto min_x = std::numeric_limits<int>::max();
+    auto min_y = std::numeric_limits<int>::max();
+    auto max_x = std::numeric_limits<int>::min();
+    auto max_y = std::numeric_limits<int>::min();
+    for (auto i = std::size_t{ 0 }; i < points.size(); ++i)
+    {
+        min_x = std::min(min_x, points[i].X());
+        min_y = std::min(min_y, points[i].Y());
+        max_x = std::max(max_x, points[i].X());
+        max_y = std::max(max_y, points[i].Y());
+    }
+    return point_box{ min_x, min_y, max_x, max_y };
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../point-v1.hxx"
+#include "../../point-v4.hxx"
+#include "point_kernels.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args) 
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+constexpr auto repeats = 20;
+
+struct timings
+{
+    double grow_ms;         ///< push_back without reserve, page faults included
+    double relocate_ms;     ///< Moving every point into warm storage, as reallocation does
+    double translate_mps;   ///< Million points per second
+    double sum_mps;
+    double bbox_mps;
+    std::int64_t check;
+};
+
+/// Best of `repeats` runs of `f`, in microseconds.
+template <typename F>
+auto best_us(F&& f) -> double
+{
+    auto b = std::numeric_limits<double>::max();
+    for (auto r = 0; r < repeats; ++r)
+    {
+        auto [us, _] = measure<std::chrono::nanoseconds>::execution([&]() { f(); return 0; });
+        b = std::min(b, static_cast<double>(us) / 1000.0);
+    }
+    return b;
+}
+
+template <typename P>
+auto run(const std::vector<std::pair<int, int>>& coords) -> timings
+{
+    auto n = static_cast<double>(coords.size());
+    auto t = timings{};
+
+    auto [grow_us, points] = measure<>::execution([&]()
+    {
+        auto v = std::vector<P>{};
+        for (auto [x, y] : coords)
+            v.push_back(P{ x, y });
+        return v;
+    });
+    t.grow_ms = grow_us / 1000.0;
+
+    t.translate_mps = n / best_us([&]() { translate(std::span<P>{ points }, 3, -3); });
+    auto s = point_sum{};
+    t.sum_mps = n / best_us([&]() { s = sum(std::span<const P>{ points }); });
+    auto box = point_box{};
+    t.bbox_mps = n / best_us([&]() { box = bounding_box(std::span<const P>{ points }); });
+    /// Last, as moving from a `v1::Point` resets the source.
+    auto storage = std::make_unique<std::byte[]>(sizeof(P) * coords.size());
+    std::fill_n(storage.get(), sizeof(P) * coords.size(), std::byte{ 0 });
+    auto* dest = reinterpret_cast<P*>(storage.get());
+    auto relocated = std::vector<P>(points);
+    t.relocate_ms = best_us([&]() { std::uninitialized_move(relocated.begin(), relocated.end(), dest); }) / 1000.0;
+
+    t.check = s.x + s.y + box.min_x + box.max_y + points[coords.size() / 2].X();
+    return t;
+}
+
+auto print(std::size_t count, const std::string& name, const timings& t) -> void
+{
+    std::cout << "| " << std::setw(10) << count << " | " << std::setw(9) << name << " | "
+              << std::setw(9) << t.grow_ms << " | " << std::setw(9) << t.relocate_ms << " | "
+              << std::setw(10) << t.translate_mps << " | " << std::setw(10) << t.sum_mps << " | "
+              << std::setw(10) << t.bbox_mps << " | " << std::setw(16) << t.check << " |" << std::endl;
+}
+
+auto main() -> int
+{
+    auto gen = std::mt19937{ 42 };
+    auto coord = std::uniform_int_distribution<int>{ -1'000'000, 1'000'000 };
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Grow and relocate in ms; kernels in Mpoints/sec (best of " << repeats << ").\n";
+    std::cout << "+------------+-----------+-----------+-----------+------------+------------+------------+------------------+" << std::endl;
+    std::cout << "|   Points   |   Point   |   Grow    | Relocate  | Translate  |    Sum     |  Bound Box |     Checksum     |" << std::endl;
+    std::cout << "+------------+-----------+-----------+-----------+------------+------------+------------+------------------+" << std::endl;
+
+    /// Cache-resident, then far bigger than the last-level cache.
+    for (auto count : { std::size_t{ 4'096 }, std::size_t{ 10'000'000 } })
+    {
+        auto coords = std::vector<std::pair<int, int>>(count);
+        for (auto& [x, y] : coords)
+        {
+            x = coord(gen);
+            y = coord(gen);
+        }
+
+        print(count, "v1::Point", run<v1::Point>(coords));
+        print(count, "v4::Point", run<v4::Point>(coords));
+        std::cout << "+------------+-----------+-----------+-----------+------------+------------+------------+------------------+" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../point-v1.hxx"
+#include "space_filling_curve.hxx"
+#include "triple.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args) 
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+constexpr auto side_2d = 2048;     ///< 4M points
+constexpr auto side_3d = 160;      ///< 4M triples
+constexpr auto passes  = 10;
+
+/// A dataset as it arrives: positions, a value per element and the indices
+/// of each element's grid neighbours (periodic), all in one arbitrary order.
+template <typename V, std::size_t Degree>
+struct dataset
+{
+    std::vector<V> positions;
+    std::vector<float> values;
+    std::vector<std::array<std::uint32_t, Degree>> neighbours;
+};
+
+/// Shuffles a dataset generated in grid order, renumbering the neighbour
+/// lists to match.
+template <typename V, std::size_t Degree>
+auto shuffle(dataset<V, Degree>& d, std::mt19937& gen) -> void
+{
+    auto order = std::vector<std::uint32_t>(d.positions.size());
+    std::iota(order.begin(), order.end(), std::uint32_t{ 0 });
+    std::ranges::shuffle(order, gen);
+
+    apply_permutation(order, d.positions, d.values, d.neighbours);
+    auto where = invert_permutation(order);
+    for (auto& ns : d.neighbours)
+        for (auto& n : ns)
+            n = where[n];
+}
+
+auto make_points(std::mt19937& gen) -> dataset<v1::Point, 4>
+{
+    auto jitter = std::uniform_int_distribution<int>{ 0, 99 };
+    auto d = dataset<v1::Point, 4>{};
+    auto at = [](int x, int y) { return static_cast<std::uint32_t>(((y + side_2d) % side_2d) * side_2d + (x + side_2d) % side_2d); };
+
+    for (auto y = 0; y < side_2d; ++y)
+        for (auto x = 0; x < side_2d; ++x)
+        {
+            d.positions.emplace_back(x * 100 + jitter(gen), y * 100 + jitter(gen));
+            d.values.push_back(static_cast<float>(x ^ y));
+            d.neighbours.push_back({ at(x - 1, y), at(x + 1, y), at(x, y - 1), at(x, y + 1) });
+        }
+
+    shuffle(d, gen);
+    return d;
+}
+
+auto make_triples(std::mt19937& gen) -> dataset<Triple<float>, 6>
+{
+    auto jitter = std::uniform_real_distribution<float>{ 0.0f, 0.99f };
+    auto d = dataset<Triple<float>, 6>{};
+    auto at = [](int x, int y, int z)
+    {
+        auto w = [](int v) { return (v + side_3d) % side_3d; };
+        return static_cast<std::uint32_t>((w(z) * side_3d + w(y)) * side_3d + w(x));
+    };
+
+    for (auto z = 0; z < side_3d; ++z)
+        for (auto y = 0; y < side_3d; ++y)
+            for (auto x = 0; x < side_3d; ++x)
+            {
+                d.positions.push_back(Triple<float>{ x + jitter(gen), y + jitter(gen), z + jitter(gen) });
+                d.values.push_back(static_cast<float>(x ^ y ^ z));
+                d.neighbours.push_back({ at(x - 1, y, z), at(x + 1, y, z), at(x, y - 1, z),
+                                         at(x, y + 1, z), at(x, y, z - 1), at(x, y, z + 1) });
+            }
+
+    shuffle(d, gen);
+    return d;
+}
+
+/// `passes` Jacobi-style smoothing passes: each value moves halfway to the
+/// mean of its neighbours. Returns the sum of the final values.
+template <std::size_t Degree>
+auto stencil(std::vector<float> values, const std::vector<std::array<std::uint32_t, Degree>>& neighbours) -> double
+{
+    auto next = std::vector<float>(values.size());
+    for (auto p = 0; p < passes; ++p)
+    {
+        for (auto i = std::size_t{ 0 }; i < values.size(); ++i)
+        {
+            auto sum = 0.0f;
+            for (auto n : neighbours[i])
+                sum += values[n];
+            next[i] = 0.5f * values[i] + 0.5f * sum / Degree;
+        }
+        values.swap(next);
+    }
+    return std::accumulate(values.begin(), values.end(), 0.0);
+}
+
+template <typename V, std::size_t Degree>
+auto run(const std::string& name, const dataset<V, Degree>& arrived) -> void
+{
+    auto [base_us, base_sum] = measure<>::execution([&]() { return stencil(arrived.values, arrived.neighbours); });
+    std::cout << "| " << std::setw(14) << name << " | " << std::setw(9) << "arbitrary" << " | " << std::setw(10) << "-" << " | "
+              << std::setw(10) << base_us / 1000.0 / passes << " | " << std::setw(7) << 1.0 << "x | "
+              << std::setw(14) << base_sum << " |" << std::endl;
+
+    for (auto [kind, label] : { std::pair{ curve::morton, "morton" }, std::pair{ curve::hilbert, "hilbert" } })
+    {
+        auto d = arrived;
+        auto [reorder_us, _] = measure<>::execution([&]()
+        {
+            auto order = curve_order(std::span<const V>{ d.positions }, kind);
+            apply_permutation(order, d.positions, d.values, d.neighbours);
+
+            /// Neighbour lists hold element indices, which move too.
+            auto where = invert_permutation(order);
+            for (auto& ns : d.neighbours)
+                for (auto& n : ns)
+                    n = where[n];
+            return 0;
+        });
+
+        auto [us, sum] = measure<>::execution([&]() { return stencil(d.values, d.neighbours); });
+        std::cout << "| " << std::setw(14) << name << " | " << std::setw(9) << label << " | "
+                  << std::setw(10) << reorder_us / 1000.0 << " | " << std::setw(10) << us / 1000.0 / passes << " | "
+                  << std::setw(7) << static_cast<double>(base_us) / us << "x | " << std::setw(14) << sum << " |" << std::endl;
+    }
+}
+
+auto main() -> int
+{
+    auto gen = std::mt19937{ 42 };
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Reorder and per-pass stencil times in ms; " << passes << " passes.\n";
+    std::cout << "+----------------+-----------+------------+------------+----------+----------------+" << std::endl;
+    std::cout << "|    Dataset     |   Order   |  Reorder   |    Pass    | Speedup  |    Checksum    |" << std::endl;
+    std::cout << "+----------------+-----------+------------+------------+----------+----------------+" << std::endl;
+
+    run("2D v1::Point", make_points(gen));
+    std::cout << "+----------------+-----------+------------+------------+----------+----------------+" << std::endl;
+    run("3D Triple", make_triples(gen));
+    std::cout << "+----------------+-----------+------------+------------+----------+----------------+" << std::endl;
+
+    return 0;
+}
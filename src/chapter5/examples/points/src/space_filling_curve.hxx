@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "point_box.hxx"
+#include "point_kernels.hxx"
+#include "radix_sort.hxx"
+
+/// Space-filling curve keys and reordering.
+///
+/// Sorting a dataset by the position of each element along a Morton
+/// (Z-order) or Hilbert curve puts elements that are close in space close
+/// in memory, so a pass that visits each element's neighbours mostly hits
+/// cache lines that are already loaded. Hilbert keys cost more to compute
+/// but never jump across the domain the way Z-order does at quadrant
+/// boundaries.
+///
+/// `curve_order` computes keys for 2D points or 3D triples in parallel and
+/// radix sorts them into a permutation; `apply_permutation` then reorders
+/// the dataset and any companion arrays with that permutation.
+
+enum class curve
+{
+    morton,
+    hilbert
+};
+
+/// Maps a signed coordinate onto the unsigned range, keeping its order.
+constexpr auto
+to_curve_coord(int v) noexcept -> std::uint32_t
+{ return static_cast<std::uint32_t>(v) ^ 0x80000000u; }
+
+namespace sfc_detail
+{
+    /// Spreads the 32 bits of `v` to the even bits of the result.
+    constexpr auto
+    spread2(std::uint32_t v) noexcept -> std::uint64_t
+    {
+        auto w = std::uint64_t{ v };
+        w = (w | (w << 16)) & 0x0000ffff0000ffffull;
+        w = (w | (w << 8))  & 0x00ff00ff00ff00ffull;
+        w = (w | (w << 4))  & 0x0f0f0f0f0f0f0f0full;
+        w = (w | (w << 2))  & 0x3333333333333333ull;
+        w = (w | (w << 1))  & 0x5555555555555555ull;
+        return w;
+    }
+
+    /// Spreads the low 21 bits of `v` to every third bit of the result.
+    constexpr auto
+    spread3(std::uint32_t v) noexcept -> std::uint64_t
+    {
+        auto w = std::uint64_t{ v } & 0x1fffff;
+        w = (w | (w << 32)) & 0x001f00000000ffffull;
+        w = (w | (w << 16)) & 0x001f0000ff0000ffull;
+        w = (w | (w << 8))  & 0x100f00f00f00f00full;
+        w = (w | (w << 4))  & 0x10c30c30c30c30c3ull;
+        w = (w | (w << 2))  & 0x1249249249249249ull;
+        return w;
+    }
+}
+
+/// Interleaves `x` and `y` (x in the even bits).
+constexpr auto
+morton_code(std::uint32_t x, std::uint32_t y) noexcept -> std::uint64_t
+{ return sfc_detail::spread2(x) | (sfc_detail::spread2(y) << 1); }
+
+/// Interleaves the low 21 bits of `x`, `y` and `z`.
+constexpr auto
+morton_code(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept -> std::uint64_t
+{ return sfc_detail::spread3(x) | (sfc_detail::spread3(y) << 1) | (sfc_detail::spread3(z) << 2); }
+
+/// Distance along the Hilbert curve filling the 2^Bits x 2^Bits grid.
+/// Coordinates must be below 2^Bits; a smaller grid costs fewer iterations
+/// and gives shorter keys.
+template <int Bits = 32>
+    requires (Bits > 0 && Bits <= 32)
+constexpr auto
+hilbert_code(std::uint32_t x, std::uint32_t y) noexcept -> std::uint64_t
+{
+    auto d = std::uint64_t{ 0 };
+    for (auto s = std::uint32_t{ 1 } << (Bits - 1); s > 0; s >>= 1)
+    {
+        auto rx = (x & s) ? 1u : 0u;
+        auto ry = (y & s) ? 1u : 0u;
+        d += std::uint64_t{ s } * s * ((3 * rx) ^ ry);
+
+        /// Rotate the quadrant so the sub-curve is in standard orientation.
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = ~x;
+                y = ~y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/// Distance along the Hilbert curve filling the 2^Bits cube, using
+/// Skilling's transpose formulation ("Programming the Hilbert curve", 2004).
+template <int Bits = 21>
+    requires (Bits > 0 && Bits <= 21)
+constexpr auto
+hilbert_code(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept -> std::uint64_t
+{
+    auto axes = std::array<std::uint32_t, 3>{ x & 0x1fffff, y & 0x1fffff, z & 0x1fffff };
+
+    /// Inverse undo of the excess work.
+    for (auto q = std::uint32_t{ 1 } << (Bits - 1); q > 1; q >>= 1)
+    {
+        auto p = q - 1;
+        for (auto& a : axes)
+        {
+            if (a & q)
+                axes[0] ^= p;
+            else
+            {
+                auto t = (axes[0] ^ a) & p;
+                axes[0] ^= t;
+                a ^= t;
+            }
+        }
+    }
+
+    /// Gray encode.
+    axes[1] ^= axes[0];
+    axes[2] ^= axes[1];
+    auto t = std::uint32_t{ 0 };
+    for (auto q = std::uint32_t{ 1 } << (Bits - 1); q > 1; q >>= 1)
+        if (axes[2] & q)
+            t ^= q - 1;
+    for (auto& a : axes)
+        a ^= t;
+
+    /// The transposed key has axes[0] as the most significant of each
+    /// triple of bits.
+    return morton_code(axes[2], axes[1], axes[0]);
+}
+
+/// Anything with public `x`, `y` and `z` arithmetic members, such as
+/// `Triple<T>`.
+template <typename V>
+concept spatial_triple = requires (const V& v)
+{
+    requires std::is_arithmetic_v<decltype(v.x)>;
+    requires std::is_arithmetic_v<decltype(v.y)>;
+    requires std::is_arithmetic_v<decltype(v.z)>;
+};
+
+namespace sfc_detail
+{
+    /// Maps `v` in `[lo, hi]` onto `[0, 2^bits)`.
+    inline auto
+    quantize(double v, double lo, double hi, int bits) noexcept -> std::uint32_t
+    {
+        auto cells = static_cast<double>((std::uint64_t{ 1 } << bits) - 1);
+        auto span = hi - lo;
+        return span > 0 ? static_cast<std::uint32_t>((v - lo) / span * cells) : 0;
+    }
+
+    /// `0, 1, ..., n - 1` as a vector. The parallel algorithms run a
+    /// `std::views::iota` range on the calling thread, so per-element loops
+    /// iterate over this instead.
+    inline auto
+    indices(std::size_t n) -> std::vector<std::size_t>
+    {
+        auto is = std::vector<std::size_t>(n);
+        std::iota(is.begin(), is.end(), std::size_t{ 0 });
+        return is;
+    }
+
+    inline auto
+    sort_by_keys(std::vector<std::uint64_t> keys) -> std::vector<std::uint32_t>
+    {
+        auto ids = std::vector<std::uint32_t>(keys.size());
+        std::iota(ids.begin(), ids.end(), std::uint32_t{ 0 });
+        radix_sort(std::span{ keys }, std::span{ ids });
+        return ids;
+    }
+}
+
+/// Coordinates are quantised to this many bits per axis before keying. That
+/// is far finer than any cache effect needs, and keeps keys to 48 bits so
+/// the radix sort skips the two top passes.
+inline constexpr auto point_curve_bits  = 24;
+inline constexpr auto triple_curve_bits = 16;
+
+/// Curve key of every point, in parallel. Coordinates are scaled to the
+/// bounding box of the dataset.
+template <planar_point P>
+auto
+curve_keys(std::span<const P> points, curve kind) -> std::vector<std::uint64_t>
+{
+    auto box = bounding_box(points);
+    auto keys = std::vector<std::uint64_t>(points.size());
+    auto is = sfc_detail::indices(points.size());
+    std::for_each(std::execution::par_unseq, is.begin(), is.end(), [&](std::size_t i)
+    {
+        auto x = sfc_detail::quantize(points[i].X(), box.min_x, box.max_x, point_curve_bits);
+        auto y = sfc_detail::quantize(points[i].Y(), box.min_y, box.max_y, point_curve_bits);
+        keys[i] = kind == curve::morton ? morton_code(x, y) : hilbert_code<point_curve_bits>(x, y);
+    });
+    return keys;
+}
+
+template <spatial_triple V>
+auto
+curve_keys(std::span<const V> triples, curve kind) -> std::vector<std::uint64_t>
+{
+    constexpr auto lowest = std::numeric_limits<double>::lowest();
+    constexpr auto highest = std::numeric_limits<double>::max();
+    auto lo = std::array{ highest, highest, highest };
+    auto hi = std::array{ lowest, lowest, lowest };
+    for (const auto& v : triples)
+    {
+        auto c = std::array{ static_cast<double>(v.x), static_cast<double>(v.y), static_cast<double>(v.z) };
+        for (auto a = 0; a < 3; ++a)
+        {
+            lo[a] = std::min(lo[a], c[a]);
+            hi[a] = std::max(hi[a], c[a]);
+        }
+    }
+
+    auto keys = std::vector<std::uint64_t>(triples.size());
+    auto is = sfc_detail::indices(triples.size());
+    std::for_each(std::execution::par_unseq, is.begin(), is.end(), [&](std::size_t i)
+    {
+        const auto& v = triples[i];
+        auto x = sfc_detail::quantize(static_cast<double>(v.x), lo[0], hi[0], triple_curve_bits);
+        auto y = sfc_detail::quantize(static_cast<double>(v.y), lo[1], hi[1], triple_curve_bits);
+        auto z = sfc_detail::quantize(static_cast<double>(v.z), lo[2], hi[2], triple_curve_bits);
+        keys[i] = kind == curve::morton ? morton_code(x, y, z) : hilbert_code<triple_curve_bits>(x, y, z);
+    });
+    return keys;
+}
+
+/// Permutation that sorts the dataset along the curve: element `i` of the
+/// reordered data is element `order[i]` of the original.
+template <typename V>
+    requires planar_point<V> || spatial_triple<V>
+auto
+curve_order(std::span<const V> data, curve kind) -> std::vector<std::uint32_t>
+{
+    if (data.size() > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("Too Many Elements");
+
+    return sfc_detail::sort_by_keys(curve_keys(data, kind));
+}
+
+/// Reorders every array in `arrays` by `order` in parallel. All arrays must
+/// have `order.size()` elements.
+template <typename... Ts>
+auto
+apply_permutation(std::span<const std::uint32_t> order, std::vector<Ts>&... arrays) -> void
+{
+    if (((arrays.size() != order.size()) || ...))
+        throw std::length_error("Size Mismatch");
+
+    auto is = sfc_detail::indices(order.size());
+    auto gather = [&](auto& array)
+    {
+        using value_type = typename std::remove_reference_t<decltype(array)>::value_type;
+        auto out = std::vector<value_type>(array.size());
+        std::for_each(std::execution::par_unseq, is.begin(), is.end(), [&](std::size_t i)
+        { out[i] = array[order[i]]; });
+        array.swap(out);
+    };
+    (gather(arrays), ...);
+}
+
+/// Inverse of a permutation: where each original element ended up. Needed
+/// to renumber companion arrays that hold element indices (such as
+/// neighbour lists).
+inline auto
+invert_permutation(std::span<const std::uint32_t> order) -> std::vector<std::uint32_t>
+{
+    auto inverse = std::vector<std::uint32_t>(order.size());
+    auto is = sfc_detail::indices(order.size());
+    std::for_each(std::execution::par_unseq, is.begin(), is.end(), [&](std::size_t i)
+    { inverse[order[i]] = static_cast<std::uint32_t>(i); });
+    return inverse;
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "ring.hxx"
+
+/// Moving window over the last `N` samples of a stream, with its sum, mean,
+/// minimum and maximum maintained incrementally.
+///
+/// Samples are kept in a `ring<T, N>`; pushing into a full window evicts
+/// the oldest sample. The sum is updated by adding the new sample and
+/// subtracting the evicted one; for floating-point samples it carries a
+/// compensation term (Neumaier summation) so that the error does not grow
+/// with the number of samples streamed through. The minimum and maximum
+/// are the fronts of two monotonic deques, themselves rings, holding only
+/// the samples that can still become the extremum: a new sample removes
+/// every sample behind it that it beats, because those leave the window
+/// first. Every sample enters and leaves each deque at most once, so
+/// `push_back` and `pop_front` are amortised O(1) whatever the window size.
+template<typename T, std::size_t N>
+    requires std::is_arithmetic_v<T>
+class ring_window
+{
+public:
+
+    using size_type         = std::size_t;
+    using value_type        = T;
+    using sum_type          = std::conditional_t<std::is_floating_point_v<T>,
+                                                 std::common_type_t<T, double>,
+                                                 std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+    using samples_type      = ring<T, N>;
+
+private:
+
+    /// A sample in one of the monotonic deques, tagged with its position in
+    /// the stream so eviction can tell whether it is the one leaving.
+    struct entry
+    {
+        size_type seq;
+        value_type value;
+    };
+
+    samples_type m_samples;
+    ring<entry, N> m_min;
+    ring<entry, N> m_max;
+    sum_type m_sum;
+    sum_type m_compensation;
+    size_type m_pushed;
+    size_type m_popped;
+
+public:
+
+    constexpr ring_window()
+        : m_samples{}
+        , m_min{}
+        , m_max{}
+        , m_sum{ 0 }
+        , m_compensation{ 0 }
+        , m_pushed{ 0 }
+        , m_popped{ 0 }
+    { }
+
+    constexpr auto
+    size() const noexcept -> size_type
+    { return m_samples.size(); }
+
+    constexpr auto
+    capacity() const noexcept -> size_type
+    { return N; }
+
+    constexpr auto
+    empty() const noexcept -> bool
+    { return m_samples.empty(); }
+
+    constexpr auto
+    full() const noexcept -> bool
+    { return m_samples.full(); }
+
+    /// The samples in the window, oldest first.
+    constexpr auto
+    samples() const noexcept -> const samples_type&
+    { return m_samples; }
+
+    /// Appends `item`, evicting the oldest sample first if the window is
+    /// full.
+    constexpr auto
+    push_back(const value_type& item) -> void
+    {
+        if (full())
+            pop_front();
+
+        m_samples.push_back(item);
+        _M_accumulate(static_cast<sum_type>(item));
+
+        while (!m_min.empty() && !(m_min.back().value < item))
+            m_min.pop_back();
+        m_min.push_back(entry{ m_pushed, item });
+
+        while (!m_max.empty() && !(item < m_max.back().value))
+            m_max.pop_back();
+        m_max.push_back(entry{ m_pushed, item });
+
+        m_pushed += 1L;
+    }
+
+    /// Removes and returns the oldest sample.
+    constexpr auto
+    pop_front() -> value_type
+    {
+        auto item = m_samples.pop_front();
+        _M_accumulate(-static_cast<sum_type>(item));
+
+        if (m_min.front().seq == m_popped)
+            m_min.pop_front();
+        if (m_max.front().seq == m_popped)
+            m_max.pop_front();
+
+        m_popped += 1L;
+        return item;
+    }
+
+    constexpr auto
+    sum() const noexcept -> sum_type
+    { return m_sum + m_compensation; }
+
+    constexpr auto
+    mean() const -> double
+    {
+        _M_nonempty_check();
+        return static_cast<double>(sum()) / static_cast<double>(size());
+    }
+
+    constexpr auto
+    min() const -> value_type
+    {
+        _M_nonempty_check();
+        return m_min.front().value;
+    }
+
+    constexpr auto
+    max() const -> value_type
+    {
+        _M_nonempty_check();
+        return m_max.front().value;
+    }
+
+private:
+
+    constexpr auto
+    _M_nonempty_check() const -> void
+    {
+        if (empty())
+            throw std::runtime_error("Window Empty");
+    }
+
+    constexpr auto
+    _M_accumulate(sum_type v) noexcept -> void
+    {
+        if constexpr (std::is_floating_point_v<sum_type>)
+        {
+            auto t = m_sum + v;
+            if (std::abs(m_sum) >= std::abs(v))
+                m_compensation += (m_sum - t) + v;
+            else
+                m_compensation += (v - t) + m_sum;
+            m_sum = t;
+        }
+        else
+            m_sum += v;
+    }
+};
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ring.hxx"
+#include "ring_window.hxx"
+
+/// Length of the sample stream. The incremental window is timed over all
+/// of it after the first `N` samples.
+static constexpr auto samples = std::size_t{ 1 } << 24;
+
+/// Budget of element visits for the recompute baseline, which costs O(N)
+/// per sample; larger windows time fewer samples.
+static constexpr auto recompute_budget = std::size_t{ 1 } << 30;
+
+struct aggregates
+{
+    double sum;
+    double min;
+    double max;
+};
+
+/// Today's approach: push into the ring, then walk all of it. Both
+/// approaches fill the window before the clock starts, so every timed
+/// sample also evicts one.
+template<std::size_t N>
+auto recompute(const std::vector<double>& stream, std::size_t count) -> std::pair<double, aggregates>
+{
+    auto r = ring<double, N>{};
+    auto last = aggregates{};
+    for (auto i = std::size_t{ 0 }; i < N; ++i)
+        r.push_back(stream[i]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto i = N; i < N + count; ++i)
+    {
+        if (r.full())
+            r.pop_front();
+        r.push_back(stream[i]);
+
+        auto a = aggregates{ 0.0, r.front(), r.front() };
+        for (const auto& e : r)
+        {
+            a.sum += e;
+            a.min = std::min(a.min, e);
+            a.max = std::max(a.max, e);
+        }
+        last = a;
+    }
+    auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    return { ns / static_cast<double>(count), last };
+}
+
+template<std::size_t N>
+auto incremental(const std::vector<double>& stream, std::size_t count) -> std::pair<double, aggregates>
+{
+    auto w = std::make_unique<ring_window<double, N>>();
+    auto last = aggregates{};
+    for (auto i = std::size_t{ 0 }; i < N; ++i)
+        w->push_back(stream[i]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto i = N; i < N + count; ++i)
+    {
+        w->push_back(stream[i]);
+        last = aggregates{ w->sum(), w->min(), w->max() };
+    }
+    auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    return { ns / static_cast<double>(count), last };
+}
+
+template<std::size_t N>
+auto row(const std::vector<double>& stream) -> void
+{
+    auto count = std::clamp(recompute_budget / N, std::size_t{ 64 }, samples - N);
+    auto [inc_ns, inc] = incremental<N>(stream, samples - N);
+    auto [inc_short_ns, inc_short] = incremental<N>(stream, count);
+    auto [rec_ns, rec] = recompute<N>(stream, count);
+
+    auto agree = std::abs(inc_short.sum - rec.sum) <= 1e-6 * std::max(1.0, std::abs(rec.sum))
+              && inc_short.min == rec.min
+              && inc_short.max == rec.max;
+
+    std::cout << "| " << std::setw(9) << N
+              << " | " << std::setw(11) << inc_ns << " ns"
+              << " | " << std::setw(11) << rec_ns << " ns"
+              << " | " << std::setw(8) << rec_ns / inc_ns << "x"
+              << " | " << (agree ? "  ok  " : " FAIL ") << " |" << std::endl;
+    std::cout << "+-----------+----------------+----------------+-----------+--------+" << std::endl;
+}
+
+auto main() -> int
+{
+    auto gen = std::mt19937_64{ 42 };
+    auto dist = std::normal_distribution<double>{ 0.0, 100.0 };
+    auto stream = std::vector<double>(samples);
+    std::ranges::generate(stream, [&]() { return dist(gen); });
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Per-sample cost of updating sum, min and max" << std::endl;
+    std::cout << "+-----------+----------------+----------------+-----------+--------+" << std::endl;
+    std::cout << "|  Window   |  ring_window   |   Recompute    |  Speedup  | Agrees |" << std::endl;
+    std::cout << "+-----------+----------------+----------------+-----------+--------+" << std::endl;
+
+    row<64>(stream);
+    row<1'024>(stream);
+    row<16'384>(stream);
+    row<262'144>(stream);
+    row<1'048'576>(stream);
+
+    return 0;
+}
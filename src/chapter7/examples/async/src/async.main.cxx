@@ -10,6 +10,8 @@
 #include <utility>
 #include <vector>
 
+#include "trace.hxx"
+
 template <typename time_t = std::chrono::microseconds>
 struct measure
 {
@@ -17,6 +19,7 @@ struct measure
     static auto execution(F func, Args&&... args) 
         -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
     {
+        TRACE_SCOPE("bench", "execution");
         auto start = std::chrono::system_clock::now();
         auto result = std::invoke(func, std::forward<Args>(args)...);
         auto duration = std::chrono::duration_cast<time_t>(std::chrono::system_clock::now() - start);
@@ -27,6 +30,7 @@ struct measure
 template<std::random_access_iterator I, std::sentinel_for<I> S, std::movable A>
 auto parallel_sum(I first, S last, A init) -> A
 {
+    TRACE_SCOPE("task", "parallel_sum");
     auto middle = first + ((last - first) / 2);
     
     /// Launch async sum on last half of the values 
@@ -36,11 +40,12 @@ auto parallel_sum(I first, S last, A init) -> A
     auto result = parallel_sum(first, middle, init);
 
     /// Obtain the future and sum with the result
-    return result + future.get();
+    return result + TRACE_WAIT("future wait", "get", future.get());
 }
 
 auto main() -> int
 {
+    TRACE_THREAD_NAME("main");
     auto v1 = std::vector<double>(999, 0.1);
     auto v2 = std::vector<double>(100'000'007, 0.1);
 
@@ -78,5 +83,7 @@ auto main() -> int
     std::cout << "Time: " << par_time_v2 << " us\n";
     std::cout << "Result: " << par_result_v2 << std::endl;
 
+    TRACE_DUMP("async.trace.json");
+
     return 0;
 }
\ No newline at end of file
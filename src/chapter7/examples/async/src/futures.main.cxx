@@ -4,19 +4,25 @@
 #include <thread>
 #include <utility>
 
+#include "trace.hxx"
+
 using namespace std::literals;
 
 auto job = [](std::promise<int>&& p, auto a, auto b)
 {
+    TRACE_THREAD_NAME("job");
+    TRACE_SCOPE("task", "job");
     std::this_thread::sleep_for(3s);
     auto r = a + b;
     p.set_value(r);  
+    TRACE_INSTANT("promise", "set_value");
     std::this_thread::sleep_for(3s);
 };
 
 
 auto main() -> int
 {
+    TRACE_THREAD_NAME("main");
     auto p = std::promise<int>{};
     auto f = p.get_future();
 
@@ -24,7 +30,7 @@ auto main() -> int
 
     auto start = std::chrono::high_resolution_clock::now();
     std::cout << "Waiting for job...\n";
-    auto r          = f.get();
+    auto r          = TRACE_WAIT("future wait", "get", f.get());
     auto finish     = std::chrono::high_resolution_clock::now();
     auto duration   = std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count();
 
@@ -33,5 +39,7 @@ auto main() -> int
 
     th.join();
 
+    TRACE_DUMP("futures.trace.json");
+
     return 0;
 }
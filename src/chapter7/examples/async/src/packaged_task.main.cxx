@@ -4,10 +4,14 @@
 #include <thread>
 #include <utility>
 
+#include "trace.hxx"
+
 using namespace std::literals;
 
 auto job = [](auto a, auto b)
 {
+    TRACE_THREAD_NAME("job");
+    TRACE_SCOPE("task", "job");
     std::this_thread::sleep_for(150ms);
     auto r = a + b;
     std::this_thread::sleep_for(150ms);
@@ -16,6 +20,7 @@ auto job = [](auto a, auto b)
 
 auto main() -> int
 {
+    TRACE_THREAD_NAME("main");
     auto pkg    = std::packaged_task<int(int, int)>{ job };
     auto f      = pkg.get_future();
 
@@ -23,7 +28,7 @@ auto main() -> int
 
     auto start = std::chrono::high_resolution_clock::now();
     std::cout << "Waiting for job...\n";
-    auto r          = f.get();
+    auto r          = TRACE_WAIT("future wait", "get", f.get());
     auto finish     = std::chrono::high_resolution_clock::now();
     auto duration   = std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count();
 
@@ -32,5 +37,7 @@ auto main() -> int
 
     th.join();
 
+    TRACE_DUMP("packaged_task.trace.json");
+
     return 0;
 }
@@ -0,0 +1,398 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// A directed acyclic graph of tasks, built once and run many times by a
+/// `graph_executor`.
+///
+/// Nodes are added with `emplace()` and ordered with `precede()`. The first
+/// run (or an explicit `compile()`) freezes the graph: edges are packed into
+/// one array, each node gets its in-degree and its priority, the length of
+/// the most expensive path from it to a sink (its "bottom level"). Running
+/// nodes with the highest bottom level first keeps the critical path moving,
+/// which bounds the makespan when there are more ready tasks than workers.
+class task_graph
+{
+public:
+
+    using node = std::size_t;
+
+    task_graph() = default;
+
+    task_graph(const task_graph&) = delete;
+    auto operator= (const task_graph&) -> task_graph& = delete;
+
+    /// Adds a task. `cost` is its relative run time, used only for
+    /// prioritisation.
+    template<std::invocable F>
+    auto
+    emplace(F&& f, double cost = 1.0) -> node
+    {
+        m_tasks.emplace_back(std::forward<F>(f));
+        m_cost.push_back(cost);
+        m_edges.emplace_back();
+        m_compiled = false;
+        return m_tasks.size() - 1;
+    }
+
+    /// `before` must finish before `after` starts.
+    auto
+    precede(node before, node after) -> void
+    {
+        if (before >= size() || after >= size())
+            throw std::out_of_range("Unknown Node");
+        m_edges[before].push_back(after);
+        m_compiled = false;
+    }
+
+    auto
+    size() const noexcept -> std::size_t
+    { return m_tasks.size(); }
+
+    /// Freezes the graph. Throws if it has a cycle.
+    auto
+    compile() -> void
+    {
+        if (m_compiled)
+            return;
+
+        auto n = size();
+        m_offsets.assign(n + 1, 0);
+        for (auto i = std::size_t{ 0 }; i < n; ++i)
+            m_offsets[i + 1] = m_offsets[i] + m_edges[i].size();
+
+        m_successors.clear();
+        m_successors.reserve(m_offsets[n]);
+        m_in_degree.assign(n, 0);
+        for (const auto& out : m_edges)
+            for (auto s : out)
+            {
+                m_successors.push_back(s);
+                ++m_in_degree[s];
+            }
+
+        /// Kahn's algorithm for a topological order.
+        auto order = std::vector<node>{};
+        order.reserve(n);
+        auto degree = m_in_degree;
+        for (auto i = std::size_t{ 0 }; i < n; ++i)
+            if (!degree[i])
+                order.push_back(i);
+        for (auto k = std::size_t{ 0 }; k < order.size(); ++k)
+            for (auto s : successors(order[k]))
+                if (!--degree[s])
+                    order.push_back(s);
+
+        if (order.size() != n)
+            throw std::invalid_argument("Cycle Detected");
+
+        /// Bottom levels, sinks first.
+        m_rank.assign(n, 0.0);
+        for (auto it = order.rbegin(); it != order.rend(); ++it)
+        {
+            auto longest = 0.0;
+            for (auto s : successors(*it))
+                longest = std::max(longest, m_rank[s]);
+            m_rank[*it] = m_cost[*it] + longest;
+        }
+
+        m_roots.clear();
+        for (auto i = std::size_t{ 0 }; i < n; ++i)
+            if (!m_in_degree[i])
+                m_roots.push_back(i);
+        std::ranges::sort(m_roots, [this](node a, node b) { return m_rank[a] > m_rank[b]; });
+
+        m_pending = std::make_unique<std::atomic<std::uint32_t>[]>(n);
+        m_compiled = true;
+    }
+
+    /// Length of the critical path, in units of `cost`.
+    auto
+    critical_path() -> double
+    {
+        compile();
+        auto longest = 0.0;
+        for (auto r : m_roots)
+            longest = std::max(longest, m_rank[r]);
+        return longest;
+    }
+
+private:
+
+    friend class graph_executor;
+
+    struct successor_range
+    {
+        const node* first;
+        const node* last;
+
+        auto begin() const noexcept -> const node* { return first; }
+        auto end() const noexcept -> const node* { return last; }
+    };
+
+    auto
+    successors(node n) const noexcept -> successor_range
+    { return { m_successors.data() + m_offsets[n], m_successors.data() + m_offsets[n + 1] }; }
+
+    /// Resets the dependency counters for a run.
+    auto
+    _M_arm() noexcept -> void
+    {
+        for (auto i = std::size_t{ 0 }; i < size(); ++i)
+            m_pending[i].store(m_in_degree[i], std::memory_order_relaxed);
+    }
+
+    std::vector<std::function<void()>> m_tasks;
+    std::vector<double> m_cost;
+    std::vector<std::vector<node>> m_edges;
+
+    /// Frozen by `compile()`.
+    bool m_compiled { false };
+    std::vector<std::size_t> m_offsets;
+    std::vector<node> m_successors;
+    std::vector<std::uint32_t> m_in_degree;
+    std::vector<double> m_rank;
+    std::vector<node> m_roots;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_pending;
+};
+
+/// Runs `task_graph`s on a fixed pool of workers.
+///
+/// Each node carries an atomic count of unfinished predecessors. The worker
+/// that finishes a task decrements its successors' counts. Of the ones that
+/// reach zero, it runs the highest priority itself, straight away, and
+/// pushes the rest onto its own ready queue. No thread is woken to find out
+/// that a dependency finished. Ready queues are heaps ordered by bottom
+/// level. An idle worker takes from its own queue first, then steals the
+/// best task from the others, and blocks on `std::atomic::wait` when every
+/// queue is empty.
+class graph_executor
+{
+public:
+
+    explicit
+    graph_executor(std::size_t workers = std::thread::hardware_concurrency())
+        : m_queues(workers ? workers : 1)
+    {
+        m_pool.reserve(m_queues.size());
+        for (auto id = std::size_t{ 0 }; id < m_queues.size(); ++id)
+            m_pool.emplace_back([this, id]() { _M_work(id); });
+    }
+
+    graph_executor(const graph_executor&) = delete;
+    auto operator= (const graph_executor&) -> graph_executor& = delete;
+
+    ~graph_executor() noexcept
+    {
+        m_stop.store(true, std::memory_order_release);
+        _M_signal_all();
+        for (auto& th : m_pool)
+            th.join();
+    }
+
+    auto
+    size() const noexcept -> std::size_t
+    { return m_queues.size(); }
+
+    /// Runs every task of `g` once, respecting its edges, and blocks until
+    /// all have finished. Rethrows the first exception a task threw, after
+    /// the rest of the graph has run. Not reentrant.
+    auto
+    run(task_graph& g) -> void
+    {
+        g.compile();
+        if (!g.size())
+            return;
+
+        g._M_arm();
+        m_graph = &g;
+        m_error = nullptr;
+        m_remaining.store(g.size(), std::memory_order_relaxed);
+        m_done.store(false, std::memory_order_relaxed);
+
+        /// Roots are dealt out in priority order, so every worker starts on
+        /// the longest path it can.
+        for (auto i = std::size_t{ 0 }; i < g.m_roots.size(); ++i)
+        {
+            auto& q = m_queues[i % m_queues.size()];
+            auto lk = std::lock_guard{ q.mx };
+            q.push(g.m_rank[g.m_roots[i]], g.m_roots[i]);
+        }
+        m_queued.fetch_add(g.m_roots.size(), std::memory_order_release);
+        _M_signal_all();
+
+        m_done.wait(false, std::memory_order_acquire);
+        m_graph = nullptr;
+
+        if (m_error)
+            std::rethrow_exception(m_error);
+    }
+
+private:
+
+    /// A worker's ready queue, a max-heap on bottom level.
+    struct alignas(64) ready_queue
+    {
+        std::mutex mx;
+        std::vector<std::pair<double, task_graph::node>> heap;
+
+        auto
+        push(double rank, task_graph::node n) -> void
+        {
+            heap.emplace_back(rank, n);
+            std::ranges::push_heap(heap);
+        }
+
+        auto
+        pop() -> std::optional<task_graph::node>
+        {
+            if (heap.empty())
+                return std::nullopt;
+            std::ranges::pop_heap(heap);
+            auto n = heap.back().second;
+            heap.pop_back();
+            return n;
+        }
+    };
+
+    auto
+    _M_work(std::size_t id) -> void
+    {
+        while (true)
+        {
+            if (auto n = _M_take(id))
+            {
+                _M_execute(id, *n);
+                continue;
+            }
+
+            /// Read the signal before the last check so a push after the
+            /// check changes it and the wait falls through.
+            auto seen = m_signal.load(std::memory_order_acquire);
+            if (m_stop.load(std::memory_order_acquire))
+                return;
+            if (m_queued.load(std::memory_order_acquire))
+                continue;
+            m_signal.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    /// Own queue first, then the others, starting from the next worker.
+    auto
+    _M_take(std::size_t id) -> std::optional<task_graph::node>
+    {
+        if (!m_queued.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        for (auto k = std::size_t{ 0 }; k < m_queues.size(); ++k)
+        {
+            auto& q = m_queues[(id + k) % m_queues.size()];
+            auto lk = std::lock_guard{ q.mx };
+            if (auto n = q.pop())
+            {
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return n;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Runs `n`, then keeps running the best successor it made ready.
+    auto
+    _M_execute(std::size_t id, task_graph::node n) -> void
+    {
+        auto& g = *m_graph;
+        auto& q = m_queues[id];
+
+        while (true)
+        {
+            try
+            {
+                g.m_tasks[n]();
+            }
+            catch (...)
+            {
+                auto lk = std::lock_guard{ m_error_mx };
+                if (!m_error)
+                    m_error = std::current_exception();
+            }
+
+            auto next = std::optional<task_graph::node>{};
+            auto pushed = std::size_t{ 0 };
+            for (auto s : g.successors(n))
+            {
+                if (g.m_pending[s].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    continue;
+
+                if (next && g.m_rank[s] <= g.m_rank[*next])
+                    std::swap(s, *next);
+                if (next)
+                {
+                    auto lk = std::lock_guard{ q.mx };
+                    q.push(g.m_rank[*next], *next);
+                    ++pushed;
+                }
+                next = s;
+            }
+
+            if (pushed)
+            {
+                m_queued.fetch_add(pushed, std::memory_order_release);
+                _M_signal(pushed);
+            }
+
+            if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                m_done.store(true, std::memory_order_release);
+                m_done.notify_one();
+            }
+
+            if (!next)
+                return;
+            n = *next;
+        }
+    }
+
+    auto
+    _M_signal(std::size_t count) noexcept -> void
+    {
+        m_signal.fetch_add(1, std::memory_order_release);
+        if (count == 1)
+            m_signal.notify_one();
+        else
+            m_signal.notify_all();
+    }
+
+    auto
+    _M_signal_all() noexcept -> void
+    {
+        m_signal.fetch_add(1, std::memory_order_release);
+        m_signal.notify_all();
+    }
+
+    std::vector<ready_queue> m_queues;
+    task_graph* m_graph { nullptr };
+
+    alignas(64) std::atomic<std::size_t> m_queued { 0 };
+    alignas(64) std::atomic<std::uint32_t> m_signal { 0 };
+    alignas(64) std::atomic<std::size_t> m_remaining { 0 };
+    std::atomic<bool> m_done { false };
+    std::atomic<bool> m_stop { false };
+
+    std::mutex m_error_mx;
+    std::exception_ptr m_error;
+
+    std::vector<std::thread> m_pool;
+};
@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "task_graph.hxx"
+
+/// Usage: task_graph [work per task] [repeats]
+///
+/// Runs synthetic DAGs on `graph_executor` and as a chain of `std::async`
+/// calls whose tasks block on their predecessors' futures, the composition
+/// used by `futures` and `packaged_task`. Every node hashes its
+/// predecessors' results, so both executions are checked against a serial
+/// run.
+
+constexpr auto wide_layers  = std::size_t{ 16 };
+constexpr auto wide_width   = std::size_t{ 512 };
+constexpr auto deep_chains  = std::size_t{ 8 };
+constexpr auto deep_depth   = std::size_t{ 1024 };
+constexpr auto cross_every  = std::size_t{ 64 };
+
+/// Node ids are in topological order: every predecessor has a smaller id.
+struct dag
+{
+    std::string name;
+    std::vector<std::vector<std::size_t>> preds;
+
+    auto
+    edges() const -> std::size_t
+    {
+        auto e = std::size_t{ 0 };
+        for (const auto& p : preds)
+            e += p.size();
+        return e;
+    }
+};
+
+/// Layers of independent nodes, each depending on two in the layer above.
+auto wide(std::size_t layers, std::size_t width) -> dag
+{
+    auto g = dag{ "wide", std::vector<std::vector<std::size_t>>(layers * width) };
+    for (auto l = std::size_t{ 1 }; l < layers; ++l)
+        for (auto i = std::size_t{ 0 }; i < width; ++i)
+            g.preds[l * width + i] = { (l - 1) * width + i, (l - 1) * width + (i + 1) % width };
+    return g;
+}
+
+/// Long chains with an occasional edge from the neighbouring chain. Node
+/// `(step, chain)` is numbered `step * chains + chain`.
+auto deep(std::size_t chains, std::size_t depth) -> dag
+{
+    auto g = dag{ "deep", std::vector<std::vector<std::size_t>>(chains * depth) };
+    for (auto s = std::size_t{ 1 }; s < depth; ++s)
+        for (auto c = std::size_t{ 0 }; c < chains; ++c)
+        {
+            auto& p = g.preds[s * chains + c];
+            p.push_back((s - 1) * chains + c);
+            if (s % cross_every == 0)
+                p.push_back((s - 1) * chains + (c + 1) % chains);
+        }
+    return g;
+}
+
+/// A small task: `rounds` of xorshift over the combined inputs.
+auto work(std::uint64_t x, std::size_t rounds) -> std::uint64_t
+{
+    x |= 1;
+    for (auto r = std::size_t{ 0 }; r < rounds; ++r)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+auto compute(const dag& g, std::vector<std::uint64_t>& values, std::size_t n, std::size_t rounds) -> void
+{
+    auto x = static_cast<std::uint64_t>(n);
+    for (auto p : g.preds[n])
+        x += values[p];
+    values[n] = work(x, rounds);
+}
+
+auto checksum(const std::vector<std::uint64_t>& values) -> std::uint64_t
+{
+    auto sum = std::uint64_t{ 0 };
+    for (auto v : values)
+        sum ^= v + 0x9e3779b97f4a7c15 + (sum << 6) + (sum >> 2);
+    return sum;
+}
+
+struct result
+{
+    double best_us;
+    bool correct;
+};
+
+auto on_executor(graph_executor& ex, const dag& g, std::size_t rounds, std::size_t repeats, std::uint64_t expected) -> result
+{
+    auto values = std::vector<std::uint64_t>(g.preds.size());
+
+    /// Built once, run `repeats` times.
+    auto tg = task_graph{};
+    for (auto n = std::size_t{ 0 }; n < g.preds.size(); ++n)
+        tg.emplace([&, n] { compute(g, values, n, rounds); });
+    for (auto n = std::size_t{ 0 }; n < g.preds.size(); ++n)
+        for (auto p : g.preds[n])
+            tg.precede(p, n);
+    tg.compile();
+
+    auto r = result{ 1e300, true };
+    for (auto k = std::size_t{ 0 }; k < repeats; ++k)
+    {
+        std::ranges::fill(values, 0);
+        auto start = std::chrono::steady_clock::now();
+        ex.run(tg);
+        r.best_us = std::min(r.best_us, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        r.correct = r.correct && checksum(values) == expected;
+    }
+    return r;
+}
+
+auto on_async(const dag& g, std::size_t rounds, std::size_t repeats, std::uint64_t expected) -> result
+{
+    auto values = std::vector<std::uint64_t>(g.preds.size());
+
+    auto r = result{ 1e300, true };
+    for (auto k = std::size_t{ 0 }; k < repeats; ++k)
+    {
+        std::ranges::fill(values, 0);
+        auto start = std::chrono::steady_clock::now();
+
+        /// Futures cannot be reused, so the chain is rebuilt every run.
+        auto futures = std::vector<std::shared_future<void>>(g.preds.size());
+        try
+        {
+            for (auto n = std::size_t{ 0 }; n < g.preds.size(); ++n)
+                futures[n] = std::async(std::launch::async, [&, n]
+                {
+                    for (auto p : g.preds[n])
+                        futures[p].wait();
+                    compute(g, values, n, rounds);
+                }).share();
+        }
+        catch (...)
+        {
+            /// A failed launch leaves the tasks already started blocked on
+            /// or reading `futures` and `values`. Destroying `futures` would
+            /// free elements they still wait on, so drain every launched
+            /// task, last first, before unwinding.
+            for (auto f = futures.rbegin(); f != futures.rend(); ++f)
+                if (f->valid())
+                    f->wait();
+            throw;
+        }
+        for (auto& f : futures)
+            f.wait();
+
+        r.best_us = std::min(r.best_us, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        r.correct = r.correct && checksum(values) == expected;
+    }
+    return r;
+}
+
+static const auto line = std::string{ "+-------+--------+--------+------------------+---------------+----------------+-------+" };
+
+auto print(const dag& g, const char* runner, result r) -> void
+{
+    auto tasks = static_cast<double>(g.preds.size());
+    std::cout << "| " << std::left << std::setw(5) << g.name << std::right
+              << " | " << std::setw(6) << g.preds.size()
+              << " | " << std::setw(6) << g.edges()
+              << " | " << std::left << std::setw(16) << runner << std::right
+              << " | " << std::setw(10) << static_cast<std::uint64_t>(r.best_us) << " us"
+              << " | " << std::setw(14) << static_cast<std::uint64_t>(tasks / (r.best_us * 1e-6))
+              << " | " << std::setw(5) << (r.correct ? "ok" : "FAIL") << " |" << std::endl;
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{ 200 };
+    auto repeats = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::size_t{ 5 };
+    auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    auto ex = graph_executor{ threads };
+
+    std::cout << "Workers: " << threads << ", work per task: " << rounds << " rounds, best of " << repeats << std::endl;
+    std::cout << line << std::endl;
+    std::cout << "| Graph | Tasks  | Edges  | Runner           |     Time      |    Tasks / sec | Check |" << std::endl;
+    std::cout << line << std::endl;
+
+    for (const auto& g : { wide(wide_layers, wide_width), deep(deep_chains, deep_depth) })
+    {
+        auto serial = std::vector<std::uint64_t>(g.preds.size());
+        for (auto n = std::size_t{ 0 }; n < g.preds.size(); ++n)
+            compute(g, serial, n, rounds);
+        auto expected = checksum(serial);
+
+        print(g, "graph_executor", on_executor(ex, g, rounds, repeats, expected));
+        try
+        {
+            print(g, "std::async chain", on_async(g, rounds, repeats, expected));
+        }
+        catch (const std::system_error& e)
+        {
+            std::cout << "| " << std::left << std::setw(5) << g.name << " | std::async failed: " << e.what() << std::right << std::endl;
+        }
+        std::cout << line << std::endl;
+    }
+
+    return 0;
+}
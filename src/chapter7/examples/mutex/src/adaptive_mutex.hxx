@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+#include "spin.hxx"
+
+/// Snapshot of an `adaptive_mutex`'s contention counters.
+struct mutex_stats
+{
+    std::uint64_t acquisitions;     ///< Successful lock acquisitions
+    std::uint64_t spins;            ///< Backoff rounds spent waiting
+    std::uint64_t parks;            ///< Times a waiter blocked in the kernel
+    std::chrono::nanoseconds held;  ///< Total time the lock was held
+};
+
+/// Mutex that spins with exponential backoff before parking the thread on
+/// `std::atomic::wait` (a futex on Linux).
+///
+/// The lock word follows the classic three state futex mutex: `0` unlocked,
+/// `1` locked and `2` locked with (possible) sleepers, so an uncontended
+/// `unlock()` never makes a syscall.
+///
+/// Meets the *Lockable* requirements, so it works with `std::lock_guard`,
+/// `std::unique_lock` and `std::scoped_lock`.
+///
+/// When `CollectStats` is set the mutex records the counters in
+/// `mutex_stats`. They are only written by the lock holder so they don't add
+/// any extra contended atomic RMWs, and they live on a separate cache line
+/// from the lock word.
+template<bool CollectStats = true>
+class basic_adaptive_mutex
+{
+public:
+
+    static constexpr unsigned default_spin_limit = 10;
+
+    explicit constexpr
+    basic_adaptive_mutex(unsigned spin_limit = default_spin_limit) noexcept
+        : m_state{ unlocked }
+        , m_spin_limit{ spin_limit }
+    { }
+
+    basic_adaptive_mutex(const basic_adaptive_mutex&) = delete;
+    auto operator= (const basic_adaptive_mutex&) -> basic_adaptive_mutex& = delete;
+
+    ~basic_adaptive_mutex() noexcept = default;
+
+    auto
+    lock() noexcept -> void
+    {
+        auto expected = unlocked;
+        if (m_state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed))
+            return _M_acquired(0, 0);
+
+        /// Spin phase: wait for the lock word to clear before retrying the
+        /// CAS so waiters only read the shared line.
+        auto bo = backoff{ m_spin_limit };
+        while (bo.spin())
+        {
+            expected = m_state.load(std::memory_order_relaxed);
+            if (expected == unlocked
+                && m_state.compare_exchange_weak(expected, locked, std::memory_order_acquire, std::memory_order_relaxed))
+                return _M_acquired(bo.rounds(), 0);
+        }
+
+        /// Park phase: mark the lock as contended and sleep until woken. We
+        /// take the lock in state `2` since we can't tell if others sleep.
+        auto parks = std::uint64_t{ 0 };
+        while (m_state.exchange(contended, std::memory_order_acquire) != unlocked)
+        {
+            ++parks;
+            m_state.wait(contended, std::memory_order_relaxed);
+        }
+
+        _M_acquired(bo.rounds(), parks);
+    }
+
+    auto
+    try_lock() noexcept -> bool
+    {
+        auto expected = unlocked;
+        if (!m_state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed))
+            return false;
+
+        _M_acquired(0, 0);
+        return true;
+    }
+
+    auto
+    unlock() noexcept -> void
+    {
+        if constexpr (CollectStats)
+            _M_store(m_held, m_held.load(std::memory_order_relaxed) + (_M_now() - m_since));
+
+        if (m_state.exchange(unlocked, std::memory_order_release) == contended)
+            m_state.notify_one();
+    }
+
+    /// Counters are read with relaxed loads so the snapshot may be torn
+    /// across fields while the mutex is in use.
+    auto
+    stats() const noexcept -> mutex_stats
+    {
+        return mutex_stats{
+            m_acquisitions.load(std::memory_order_relaxed),
+            m_spins.load(std::memory_order_relaxed),
+            m_parks.load(std::memory_order_relaxed),
+            std::chrono::nanoseconds{ m_held.load(std::memory_order_relaxed) }
+        };
+    }
+
+    /// Must only be called while no thread holds the mutex.
+    auto
+    reset_stats() noexcept -> void
+    {
+        _M_store(m_acquisitions, 0);
+        _M_store(m_spins, 0);
+        _M_store(m_parks, 0);
+        _M_store(m_held, 0);
+    }
+
+private:
+
+    static constexpr std::uint32_t unlocked  = 0;
+    static constexpr std::uint32_t locked    = 1;
+    static constexpr std::uint32_t contended = 2;
+
+    static auto
+    _M_now() noexcept -> std::int64_t
+    {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    }
+
+    template<typename T>
+    static auto
+    _M_store(std::atomic<T>& a, std::type_identity_t<T> v) noexcept -> void
+    { a.store(v, std::memory_order_relaxed); }
+
+    /// Called by the new owner, so plain load + store is race free.
+    auto
+    _M_acquired(std::uint64_t spins, std::uint64_t parks) noexcept -> void
+    {
+        if constexpr (CollectStats)
+        {
+            _M_store(m_acquisitions, m_acquisitions.load(std::memory_order_relaxed) + 1);
+            _M_store(m_spins, m_spins.load(std::memory_order_relaxed) + spins);
+            _M_store(m_parks, m_parks.load(std::memory_order_relaxed) + parks);
+            m_since = _M_now();
+        }
+        else
+        {
+            (void) spins;
+            (void) parks;
+        }
+    }
+
+    std::atomic<std::uint32_t> m_state;
+    unsigned m_spin_limit;
+
+    /// The counters get their own cache line so the holder's writes don't
+    /// invalidate the line every locker CASes `m_state` on.
+    alignas(64) std::atomic<std::uint64_t> m_acquisitions { 0 };
+    std::atomic<std::uint64_t> m_spins { 0 };
+    std::atomic<std::uint64_t> m_parks { 0 };
+    std::atomic<std::int64_t> m_held { 0 };
+    std::int64_t m_since { 0 };
+};
+
+using adaptive_mutex = basic_adaptive_mutex<true>;
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "adaptive_mutex.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args)
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+constexpr auto iterations = 100'000u;
+
+/// Busy work that the optimiser can't remove, used to size critical and
+/// non-critical sections.
+auto spin_work(unsigned n, std::uint64_t seed) noexcept -> std::uint64_t
+{
+    for (auto i { 0u }; i < n; ++i)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        asm volatile("" : "+r"(seed));
+    }
+    return seed;
+}
+
+/// Every thread repeatedly takes `mx` with `std::unique_lock`, does
+/// `inside` units of work on shared state, then `outside` units privately.
+template<typename Mutex>
+auto run(Mutex& mx, unsigned thr_count, unsigned inside, unsigned outside) -> std::uint64_t
+{
+    auto shared = std::uint64_t{ 0 };
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
+
+    for (auto t { 0u }; t < thr_count; ++t)
+        pool.emplace_back([&, t]()
+        {
+            auto local = std::uint64_t{ t };
+            for (auto i { 0u }; i < iterations / thr_count; ++i)
+            {
+                {
+                    auto lk = std::unique_lock{ mx };
+                    shared = spin_work(inside, shared);
+                }
+                local = spin_work(outside, local);
+            }
+        });
+
+    for (auto& th : pool)
+        th.join();
+
+    return shared;
+}
+
+auto main() -> int
+{
+    auto max_threads = std::max(std::thread::hardware_concurrency(), 2u);
+    auto thread_counts = std::vector<unsigned>{ 1u };
+    for (auto t : { max_threads / 2, max_threads })
+        if (t > thread_counts.back())
+            thread_counts.push_back(t);
+
+    struct scenario { std::string name; unsigned inside; unsigned outside; };
+    auto scenarios = std::vector<scenario>{
+        { "short", 8, 64 },
+        { "long", 1024, 256 }
+    };
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "+----------+---------+-----------------+-------------+--------------+--------------+--------------+-------------+" << std::endl;
+    std::cout << "| Critical | Threads |      Mutex      |    Time     | Acquisitions |  Spins/acq   |  Parks/acq   | Avg Hold ns |" << std::endl;
+    std::cout << "+----------+---------+-----------------+-------------+--------------+--------------+--------------+-------------+" << std::endl;
+
+    for (const auto& [name, inside, outside] : scenarios)
+    {
+        for (auto thr_count : thread_counts)
+        {
+            auto std_mx = std::mutex{};
+            auto [std_time, std_r] = measure<>::execution([&](){ return run(std_mx, thr_count, inside, outside); });
+
+            auto bare_mx = basic_adaptive_mutex<false>{};
+            auto [bare_time, bare_r] = measure<>::execution([&](){ return run(bare_mx, thr_count, inside, outside); });
+
+            auto adaptive_mx = adaptive_mutex{};
+            auto [ad_time, ad_r] = measure<>::execution([&](){ return run(adaptive_mx, thr_count, inside, outside); });
+            auto s = adaptive_mx.stats();
+            auto acq = static_cast<double>(std::max<std::uint64_t>(s.acquisitions, 1));
+
+            std::cout << "| " << std::setw(8) << name << " | " << std::setw(7) << thr_count
+                      << " | std::mutex      | " << std::setw(8) << std_time << " us |"
+                      << "      -       |      -       |      -       |      -      |" << std::endl;
+            std::cout << "| " << std::setw(8) << name << " | " << std::setw(7) << thr_count
+                      << " | adaptive (bare) | " << std::setw(8) << bare_time << " us |"
+                      << "      -       |      -       |      -       |      -      |" << std::endl;
+            std::cout << "| " << std::setw(8) << name << " | " << std::setw(7) << thr_count
+                      << " | adaptive_mutex  | " << std::setw(8) << ad_time << " us | "
+                      << std::setw(12) << s.acquisitions << " | "
+                      << std::setw(12) << s.spins / acq << " | "
+                      << std::setw(12) << s.parks / acq << " | "
+                      << std::setw(11) << s.held.count() / acq << " |" << std::endl;
+            std::cout << "+----------+---------+-----------------+-------------+--------------+--------------+--------------+-------------+" << std::endl;
+
+            (void) std_r;
+            (void) bare_r;
+            (void) ad_r;
+        }
+    }
+
+    return 0;
+}
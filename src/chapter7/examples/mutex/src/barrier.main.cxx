@@ -6,12 +6,15 @@
 #include <thread>
 #include <vector>
 
+#include "trace.hxx"
+
 using namespace std::literals;
 
 auto thr_count  = std::thread::hardware_concurrency();
 
 auto on_completion = []() noexcept
 { 
+    TRACE_SCOPE("task", "on_completion");
     static auto message = "All jobs done.\nWorkers are at lunch before cleaning up...\n"s;
     std::osyncstream(std::cout) << message;
     std::this_thread::sleep_for(3s);
@@ -22,16 +25,24 @@ auto barrier = std::barrier{ thr_count, on_completion };
 
 auto job = [](auto job_id)
 { 
-    std::this_thread::sleep_for(2s);
-    std::osyncstream(std::cout) << "Job " << job_id << " done.\n";
-    barrier.arrive_and_wait();
-    std::osyncstream(std::cout) << "Job " << job_id << " cleaned up.\n";
-    barrier.arrive_and_wait();
+    TRACE_THREAD_NAME("job " + std::to_string(job_id));
+    {
+        TRACE_SCOPE("task", "job");
+        std::this_thread::sleep_for(2s);
+        std::osyncstream(std::cout) << "Job " << job_id << " done.\n";
+    }
+    TRACE_WAIT("barrier wait", "arrive_and_wait", barrier.arrive_and_wait());
+    {
+        TRACE_SCOPE("task", "cleanup");
+        std::osyncstream(std::cout) << "Job " << job_id << " cleaned up.\n";
+    }
+    TRACE_WAIT("barrier wait", "arrive_and_wait", barrier.arrive_and_wait());
 };
 
 auto main() -> int
 {    
-    auto pool = std::vector<std::thread>(thr_count);
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
 
     std::cout << "Starting jobs...\n";
     for (auto i { 0u }; i < thr_count; ++i)
@@ -42,6 +53,7 @@ auto main() -> int
     for (auto& th : pool)
         if (th.joinable())
             th.join();
-    
+
+    TRACE_DUMP("barrier.trace.json");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+/// Fixed capacity, open-addressing concurrent hash map.
+///
+/// Lookups are lock-free; they only ever perform atomic loads on the slot
+/// array. Writers are serialised per stripe (keys hashing to the same stripe
+/// share a mutex) so updates to one key are linearisable, while writers on
+/// different stripes proceed in parallel and only race on empty slots through
+/// a CAS on the key. Entries are never removed so a probe sequence never
+/// needs to skip tombstones.
+///
+/// `Empty` is a reserved key value used to mark unclaimed slots and can not
+/// itself be inserted.
+template<std::integral K,
+         typename V,
+         typename Hash = std::hash<K>,
+         K Empty = std::numeric_limits<K>::max()>
+    requires std::is_trivially_copyable_v<V>
+class concurrent_map
+{
+public:
+
+    using key_type      = K;
+    using mapped_type   = V;
+    using hasher        = Hash;
+    using size_type     = std::size_t;
+
+    static constexpr auto empty_key = Empty;
+
+private:
+
+    static constexpr size_type cache_line   = 64;
+    static constexpr size_type stripe_count = 64;
+
+    struct slot
+    {
+        std::atomic<key_type> key { empty_key };
+        std::atomic<mapped_type> value { };
+        std::atomic<bool> ready { false };
+    };
+
+    struct alignas(cache_line) stripe
+    { std::mutex mx; };
+
+    size_type m_mask;
+    std::unique_ptr<slot[]> m_slots;
+    std::unique_ptr<stripe[]> m_stripes;
+    alignas(cache_line) std::atomic<size_type> m_size;
+    [[no_unique_address]] hasher m_hash;
+
+public:
+
+    /// Allocates room for at least `capacity` entries, keeping the load
+    /// factor at or below 0.5 so probe chains stay short.
+    explicit
+    concurrent_map(size_type capacity = 1024)
+        : m_mask{ std::bit_ceil(capacity * 2 < 16 ? size_type{ 16 } : capacity * 2) - 1 }
+        , m_slots{ std::make_unique<slot[]>(m_mask + 1) }
+        , m_stripes{ std::make_unique<stripe[]>(stripe_count) }
+        , m_size{ 0 }
+        , m_hash{ }
+    { }
+
+    concurrent_map(const concurrent_map&) = delete;
+    concurrent_map(concurrent_map&&) = delete;
+    auto operator= (const concurrent_map&) -> concurrent_map& = delete;
+    auto operator= (concurrent_map&&) -> concurrent_map& = delete;
+
+    ~concurrent_map() noexcept = default;
+
+    constexpr auto
+    capacity() const noexcept -> size_type
+    { return m_mask + 1; }
+
+    auto
+    size() const noexcept -> size_type
+    { return m_size.load(std::memory_order_relaxed); }
+
+    auto
+    empty() const noexcept -> bool
+    { return size() == 0; }
+
+    /// Lock-free lookup.
+    auto
+    find(key_type key) const noexcept -> std::optional<mapped_type>
+    {
+        auto h = _M_hash(key);
+        for (auto i = size_type{ 0 }; i <= m_mask; ++i)
+        {
+            auto& s = m_slots[(h + i) & m_mask];
+            auto k = s.key.load(std::memory_order_acquire);
+
+            if (k == empty_key)
+                return std::nullopt;
+
+            if (k == key)
+            {
+                /// The key may have been claimed but not yet published.
+                if (!s.ready.load(std::memory_order_acquire))
+                    return std::nullopt;
+                return s.value.load(std::memory_order_acquire);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    auto
+    contains(key_type key) const noexcept -> bool
+    { return find(key).has_value(); }
+
+    /// Inserts `value` if `key` is absent. Returns `false` if the key was
+    /// already present.
+    auto
+    insert(key_type key, const mapped_type& value) -> bool
+    {
+        auto lk = std::lock_guard{ _M_stripe(key) };
+        auto& s = _M_claim(key);
+
+        if (s.ready.load(std::memory_order_relaxed))
+            return false;
+
+        _M_publish(s, value);
+        return true;
+    }
+
+    /// Inserts or overwrites the value mapped to `key`. Returns `true` if a
+    /// new entry was created.
+    auto
+    insert_or_assign(key_type key, const mapped_type& value) -> bool
+    {
+        auto lk = std::lock_guard{ _M_stripe(key) };
+        auto& s = _M_claim(key);
+
+        if (s.ready.load(std::memory_order_relaxed))
+        {
+            s.value.store(value, std::memory_order_release);
+            return false;
+        }
+
+        _M_publish(s, value);
+        return true;
+    }
+
+    /// Atomically replaces the value mapped to `key` with `f(old)`, where
+    /// `old` is value-initialised for a missing key. Returns the new value.
+    template<std::invocable<const mapped_type&> F>
+        requires std::convertible_to<std::invoke_result_t<F, const mapped_type&>, mapped_type>
+    auto
+    update(key_type key, F f) -> mapped_type
+    {
+        auto lk = std::lock_guard{ _M_stripe(key) };
+        auto& s = _M_claim(key);
+
+        if (s.ready.load(std::memory_order_relaxed))
+        {
+            auto v = static_cast<mapped_type>(std::invoke(f, s.value.load(std::memory_order_relaxed)));
+            s.value.store(v, std::memory_order_release);
+            return v;
+        }
+
+        auto v = static_cast<mapped_type>(std::invoke(f, mapped_type{}));
+        _M_publish(s, v);
+        return v;
+    }
+
+    /// Visits every published entry. Concurrent inserts may or may not be
+    /// observed; entries are visited in slot (not key) order.
+    template<std::invocable<key_type, mapped_type> F>
+    auto
+    for_each(F f) const -> void
+    {
+        for (auto i = size_type{ 0 }; i <= m_mask; ++i)
+        {
+            auto& s = m_slots[i];
+            if (s.ready.load(std::memory_order_acquire))
+                std::invoke(f, s.key.load(std::memory_order_relaxed),
+                               s.value.load(std::memory_order_acquire));
+        }
+    }
+
+private:
+
+    auto
+    _M_hash(key_type key) const noexcept -> size_type
+    {
+        /// Scramble the hash so identity hashes of sequential keys do not
+        /// produce long primary clusters.
+        auto h = static_cast<size_type>(std::invoke(m_hash, key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    auto
+    _M_stripe(key_type key) noexcept -> std::mutex&
+    { return m_stripes[_M_hash(key) % stripe_count].mx; }
+
+    /// Finds the slot owning `key`, claiming the first empty slot in its probe
+    /// sequence if it has none. Must be called with the key's stripe held.
+    auto
+    _M_claim(key_type key) -> slot&
+    {
+        if (key == empty_key)
+            throw std::invalid_argument("Reserved Key");
+
+        auto h = _M_hash(key);
+        for (auto i = size_type{ 0 }; i <= m_mask; ++i)
+        {
+            auto& s = m_slots[(h + i) & m_mask];
+            auto k = s.key.load(std::memory_order_acquire);
+
+            if (k == empty_key)
+            {
+                /// Writers from other stripes may race for this slot.
+                if (s.key.compare_exchange_strong(k, key, std::memory_order_acq_rel))
+                    return s;
+            }
+
+            if (k == key)
+                return s;
+        }
+
+        throw std::runtime_error("Map Full");
+    }
+
+    auto
+    _M_publish(slot& s, const mapped_type& value) noexcept -> void
+    {
+        s.value.store(value, std::memory_order_relaxed);
+        s.ready.store(true, std::memory_order_release);
+        m_size.fetch_add(1, std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "concurrent_map.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args)
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+constexpr auto key_range        = 1u << 16;
+constexpr auto ops_per_thread   = 200'000u;
+
+/// Cheap per-thread PRNG so key generation doesn't dominate the measurement.
+struct xorshift
+{
+    std::uint64_t state;
+
+    auto operator() () noexcept -> std::uint64_t
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+/// The pattern from `mutex.main.cxx` and `locks.main.cxx`.
+struct locked_map
+{
+    std::mutex mx;
+    std::map<int, long long> map;
+
+    auto find(int k) -> std::optional<long long>
+    {
+        auto lk = std::lock_guard{ mx };
+        if (auto it = map.find(k); it != map.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    auto insert_or_assign(int k, long long v) -> void
+    {
+        auto lk = std::lock_guard{ mx };
+        map.insert_or_assign(k, v);
+    }
+};
+
+/// Runs `thr_count` workers each doing `ops_per_thread` operations, of which
+/// `read_pct` percent are lookups and the rest writes. Returns the number of
+/// successful lookups so the work can't be optimised away.
+template<typename Map>
+auto run(Map& map, unsigned thr_count, unsigned read_pct) -> std::size_t
+{
+    auto hits = std::vector<std::size_t>(thr_count, 0);
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
+
+    for (auto t { 0u }; t < thr_count; ++t)
+        pool.emplace_back([&map, &hits, t, read_pct]()
+        {
+            auto rng = xorshift{ 0x9e3779b97f4a7c15ULL * (t + 1) };
+            auto local = std::size_t{ 0 };
+
+            for (auto i { 0u }; i < ops_per_thread; ++i)
+            {
+                auto r = rng();
+                auto key = static_cast<int>(r % key_range);
+
+                if ((r >> 32) % 100 < read_pct)
+                    local += map.find(key).has_value();
+                else
+                    map.insert_or_assign(key, static_cast<long long>(r));
+            }
+
+            hits[t] = local;
+        });
+
+    for (auto& th : pool)
+        th.join();
+
+    auto total = std::size_t{ 0 };
+    for (auto h : hits)
+        total += h;
+    return total;
+}
+
+template<typename Map>
+auto prefill(Map& map) -> void
+{
+    for (auto k { 0u }; k < key_range; k += 2)
+        map.insert_or_assign(static_cast<int>(k), static_cast<long long>(k));
+}
+
+auto main() -> int
+{
+    auto max_threads = std::max(std::thread::hardware_concurrency(), 2u);
+    auto thread_counts = std::vector<unsigned>{};
+    for (auto t { 1u }; t < max_threads; t *= 2)
+        thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "+---------+---------+--------------------+----------------+----------------+---------+" << std::endl;
+    std::cout << "| Threads | Reads % |        Map         |      Time      |    Mops/sec    | Speedup |" << std::endl;
+    std::cout << "+---------+---------+--------------------+----------------+----------------+---------+" << std::endl;
+
+    for (auto read_pct : { 50u, 90u, 99u })
+    {
+        for (auto thr_count : thread_counts)
+        {
+            auto total_ops = static_cast<double>(thr_count) * ops_per_thread;
+
+            auto locked = locked_map{};
+            prefill(locked);
+            auto [locked_time, locked_hits] = measure<>::execution([&](){ return run(locked, thr_count, read_pct); });
+
+            auto concurrent = concurrent_map<int, long long>{ key_range };
+            prefill(concurrent);
+            auto [conc_time, conc_hits] = measure<>::execution([&](){ return run(concurrent, thr_count, read_pct); });
+
+            std::cout << "| " << std::setw(7) << thr_count << " | " << std::setw(7) << read_pct
+                      << " | std::map + mutex   | " << std::setw(11) << locked_time << " us | "
+                      << std::setw(14) << total_ops / std::max<double>(locked_time, 1) << " |  " << std::setw(6) << 1.0 << " |" << std::endl;
+            std::cout << "| " << std::setw(7) << thr_count << " | " << std::setw(7) << read_pct
+                      << " | concurrent_map     | " << std::setw(11) << conc_time << " us | "
+                      << std::setw(14) << total_ops / std::max<double>(conc_time, 1) << " |  "
+                      << std::setw(6) << static_cast<double>(locked_time) / std::max<double>(conc_time, 1) << " |" << std::endl;
+            std::cout << "+---------+---------+--------------------+----------------+----------------+---------+" << std::endl;
+
+            (void) locked_hits;
+            (void) conc_hits;
+        }
+    }
+
+    return 0;
+}
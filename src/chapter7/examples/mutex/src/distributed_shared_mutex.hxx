@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "spin.hxx"
+
+/// Reader-writer lock with one reader indicator per slot, each on its own
+/// cache line.
+///
+/// `std::shared_mutex` keeps a single reader count, so every `lock_shared()`
+/// is an RMW on the same line and read-mostly workloads stop scaling once
+/// that line starts bouncing between cores. Here each thread is assigned a
+/// slot (round robin on first use) and readers only touch their slot's line
+/// plus a read of the writer flag, which stays shared in every reader's cache
+/// while no writer is active. With as many slots as cores and pinned workers
+/// this behaves as a per-core indicator.
+///
+/// Writers are preferred: once a writer raises the flag new readers back off
+/// until it has finished. Writers pay O(slots) to drain the indicators, so
+/// this lock suits data that is read far more often than it is written.
+///
+/// Meets the *SharedLockable* requirements, so it works with
+/// `std::shared_lock`, `std::unique_lock` and `std::lock_guard`.
+class distributed_shared_mutex
+{
+public:
+
+    distributed_shared_mutex()
+        : distributed_shared_mutex(std::thread::hardware_concurrency())
+    { }
+
+    explicit
+    distributed_shared_mutex(std::size_t slots)
+        : m_slot_count{ slots ? slots : 1 }
+        , m_slots{ std::make_unique<slot[]>(m_slot_count) }
+        , m_writer{ false }
+    { }
+
+    distributed_shared_mutex(const distributed_shared_mutex&) = delete;
+    auto operator= (const distributed_shared_mutex&) -> distributed_shared_mutex& = delete;
+
+    ~distributed_shared_mutex() noexcept = default;
+
+    auto
+    lock_shared() noexcept -> void
+    {
+        auto& readers = _M_slot().readers;
+
+        while (true)
+        {
+            /// Announce ourselves, then check for a writer. Pairs with the
+            /// flag store and indicator loads in `lock()` (Dekker style) so
+            /// either we see the writer or the writer sees us.
+            readers.fetch_add(1, std::memory_order_seq_cst);
+            if (!m_writer.load(std::memory_order_seq_cst))
+                return;
+
+            readers.fetch_sub(1, std::memory_order_release);
+            _M_wait_for_writer();
+        }
+    }
+
+    auto
+    try_lock_shared() noexcept -> bool
+    {
+        auto& readers = _M_slot().readers;
+        readers.fetch_add(1, std::memory_order_seq_cst);
+        if (!m_writer.load(std::memory_order_seq_cst))
+            return true;
+
+        readers.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    auto
+    unlock_shared() noexcept -> void
+    { _M_slot().readers.fetch_sub(1, std::memory_order_release); }
+
+    auto
+    lock() noexcept -> void
+    {
+        auto bo = backoff{};
+        while (m_writer.exchange(true, std::memory_order_seq_cst))
+            if (!bo.spin())
+                m_writer.wait(true, std::memory_order_relaxed);
+
+        /// Drain the readers that got in before the flag was raised.
+        for (auto i = std::size_t{ 0 }; i < m_slot_count; ++i)
+        {
+            bo.reset();
+            while (m_slots[i].readers.load(std::memory_order_seq_cst) != 0)
+                if (!bo.spin())
+                    std::this_thread::yield();
+        }
+    }
+
+    auto
+    try_lock() noexcept -> bool
+    {
+        if (m_writer.exchange(true, std::memory_order_seq_cst))
+            return false;
+
+        for (auto i = std::size_t{ 0 }; i < m_slot_count; ++i)
+            if (m_slots[i].readers.load(std::memory_order_seq_cst) != 0)
+            {
+                unlock();
+                return false;
+            }
+
+        return true;
+    }
+
+    auto
+    unlock() noexcept -> void
+    {
+        m_writer.store(false, std::memory_order_release);
+        m_writer.notify_all();
+    }
+
+    auto
+    slots() const noexcept -> std::size_t
+    { return m_slot_count; }
+
+private:
+
+    static constexpr std::size_t cache_line = 64;
+
+    struct alignas(cache_line) slot
+    { std::atomic<std::uint32_t> readers { 0 }; };
+
+    /// Slot indices are handed out per thread, not per lock, so a thread uses
+    /// the same index in every `distributed_shared_mutex`.
+    static auto
+    _S_thread_index() noexcept -> std::size_t
+    {
+        static auto next = std::atomic<std::size_t>{ 0 };
+        thread_local auto index = next.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    auto
+    _M_slot() noexcept -> slot&
+    { return m_slots[_S_thread_index() % m_slot_count]; }
+
+    auto
+    _M_wait_for_writer() noexcept -> void
+    {
+        auto bo = backoff{};
+        while (m_writer.load(std::memory_order_relaxed))
+            if (!bo.spin())
+                m_writer.wait(true, std::memory_order_relaxed);
+    }
+
+    std::size_t m_slot_count;
+    std::unique_ptr<slot[]> m_slots;
+    alignas(cache_line) std::atomic<bool> m_writer;
+};
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// Epoch-based memory reclamation.
+///
+/// Lock-free readers may still hold a pointer to a node after a writer has
+/// unlinked it, so the writer cannot free the node straight away. Instead,
+/// every operation that touches shared nodes pins the current global epoch
+/// for its duration (`epoch_guard`). Unlinked nodes are `retire`d, tagged
+/// with the epoch they were retired in. The global epoch only advances once
+/// every pinned thread has seen it, so by the time it is two ahead of a
+/// node's tag no thread can still be reading that node, and the node is
+/// freed.
+///
+/// Pinning is a load, a store to a thread-local record and a fence, with no
+/// shared writes. Each thread keeps its own retire list and tries to advance
+/// the epoch every `collect_every` retirements. A thread that stays pinned
+/// stops reclamation for everyone, so guards should cover single operations.
+///
+/// There is one domain per process, `epoch_domain::instance()`. Thread
+/// records are reused after their thread exits. Anything still retired is
+/// freed when the domain is destroyed at program exit.
+class epoch_domain
+{
+public:
+
+    static constexpr std::size_t collect_every = 64;
+
+    static auto
+    instance() -> epoch_domain&
+    {
+        static auto d = epoch_domain{};
+        return d;
+    }
+
+    epoch_domain(const epoch_domain&) = delete;
+    auto operator= (const epoch_domain&) -> epoch_domain& = delete;
+
+    ~epoch_domain() noexcept
+    {
+        auto* r = m_records.load(std::memory_order_acquire);
+        while (r)
+        {
+            for (auto& n : r->retired)
+                n.deleter(n.ptr);
+            auto* next = r->next;
+            delete r;
+            r = next;
+        }
+    }
+
+    /// Pins the calling thread to the current epoch. Pins nest.
+    auto
+    pin() noexcept -> void
+    {
+        auto& r = _M_local();
+        if (r.depth++)
+            return;
+        auto e = m_epoch.load(std::memory_order_acquire);
+        r.state.store(e << 1 | 1, std::memory_order_relaxed);
+
+        /// Orders the pin before this thread's reads of shared nodes, and
+        /// pairs with the fence in `_M_try_advance`.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    auto
+    unpin() noexcept -> void
+    {
+        auto& r = _M_local();
+        if (--r.depth)
+            return;
+        r.state.store(0, std::memory_order_release);
+    }
+
+    /// Frees `p` with `delete` once no pinned thread can hold it. Call only
+    /// after `p` has been unlinked from every shared structure.
+    template<typename T>
+    auto
+    retire(T* p) -> void
+    { retire(p, [](void* q) { delete static_cast<T*>(q); }); }
+
+    auto
+    retire(void* p, void (*deleter)(void*)) -> void
+    {
+        auto& r = _M_local();
+        r.retired.push_back(retired_node{ p, deleter, m_epoch.load(std::memory_order_acquire) });
+        if (r.retired.size() % collect_every == 0)
+            _M_collect(r);
+    }
+
+    auto
+    epoch() const noexcept -> std::uint64_t
+    { return m_epoch.load(std::memory_order_relaxed); }
+
+private:
+
+    epoch_domain() = default;
+
+    struct retired_node
+    {
+        void* ptr;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    /// Per-thread state. `state` is `0` when unpinned, otherwise the pinned
+    /// epoch shifted left with the low bit set.
+    struct alignas(64) record
+    {
+        std::atomic<std::uint64_t> state { 0 };
+        std::atomic<bool> in_use { true };
+        std::size_t depth { 0 };
+        std::vector<retired_node> retired;
+        record* next { nullptr };
+    };
+
+    /// Releases the thread's record when the thread exits.
+    struct handle
+    {
+        record* r;
+
+        ~handle() noexcept
+        { r->in_use.store(false, std::memory_order_release); }
+    };
+
+    auto
+    _M_local() -> record&
+    {
+        thread_local auto h = handle{ _M_acquire() };
+        return *h.r;
+    }
+
+    /// Reuses a record left by an exited thread, or pushes a new one.
+    auto
+    _M_acquire() -> record*
+    {
+        for (auto* r = m_records.load(std::memory_order_acquire); r; r = r->next)
+            if (auto free = false; r->in_use.compare_exchange_strong(free, true, std::memory_order_acq_rel))
+                return r;
+
+        auto* r = new record{};
+        r->next = m_records.load(std::memory_order_relaxed);
+        while (!m_records.compare_exchange_weak(r->next, r, std::memory_order_acq_rel))
+            ;
+        return r;
+    }
+
+    /// Advances the epoch if every pinned thread has seen it.
+    auto
+    _M_try_advance() noexcept -> std::uint64_t
+    {
+        auto e = m_epoch.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto* r = m_records.load(std::memory_order_acquire); r; r = r->next)
+        {
+            auto s = r->state.load(std::memory_order_acquire);
+            if ((s & 1) && (s >> 1) != e)
+                return e;
+        }
+        m_epoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+        return m_epoch.load(std::memory_order_acquire);
+    }
+
+    auto
+    _M_collect(record& r) -> void
+    {
+        auto e = _M_try_advance();
+        auto keep = std::size_t{ 0 };
+        for (auto i = std::size_t{ 0 }; i < r.retired.size(); ++i)
+        {
+            if (r.retired[i].epoch + 2 <= e)
+                r.retired[i].deleter(r.retired[i].ptr);
+            else
+                r.retired[keep++] = r.retired[i];
+        }
+        r.retired.resize(keep);
+    }
+
+    alignas(64) std::atomic<std::uint64_t> m_epoch { 0 };
+    alignas(64) std::atomic<record*> m_records { nullptr };
+};
+
+/// Pins the calling thread to the current epoch for its lifetime.
+class epoch_guard
+{
+public:
+
+    explicit
+    epoch_guard(epoch_domain& d = epoch_domain::instance()) noexcept
+        : m_domain{ d }
+    { m_domain.pin(); }
+
+    epoch_guard(const epoch_guard&) = delete;
+    auto operator= (const epoch_guard&) -> epoch_guard& = delete;
+
+    ~epoch_guard() noexcept
+    { m_domain.unpin(); }
+
+private:
+
+    epoch_domain& m_domain;
+};
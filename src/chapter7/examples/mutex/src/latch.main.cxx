@@ -3,8 +3,11 @@
 #include <latch>
 #include <syncstream>
 #include <thread>
+#include <string>
 #include <vector>
 
+#include "trace.hxx"
+
 using namespace std::literals;
 
 auto thr_count  = std::thread::hardware_concurrency();
@@ -13,22 +16,29 @@ auto cleanup    = std::latch{ 1 };
 
 auto job = [](auto job_id)
 { 
-    std::this_thread::sleep_for(2s);
-    std::osyncstream(std::cout) << "Job " << job_id << " done.\n";
+    TRACE_THREAD_NAME("job " + std::to_string(job_id));
+    {
+        TRACE_SCOPE("task", "job");
+        std::this_thread::sleep_for(2s);
+        std::osyncstream(std::cout) << "Job " << job_id << " done.\n";
+    }
     done.count_down();
-    cleanup.wait();
+    TRACE_WAIT("latch wait", "cleanup", cleanup.wait());
+    TRACE_SCOPE("task", "cleanup");
     std::osyncstream(std::cout) << "Job " << job_id << " cleaned up.\n";
 };
 
 auto main() -> int
 {    
-    auto pool = std::vector<std::thread>(thr_count);
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
 
     std::cout << "Starting jobs...\n";
     for (auto i { 0u }; i < thr_count; ++i)
         pool.emplace_back(job, i);
 
-    done.wait();
+    TRACE_THREAD_NAME("main");
+    TRACE_WAIT("latch wait", "done", done.wait());
     std::cout << "All jobs done.\n";
     std::this_thread::sleep_for(200ms);
     std::cout << "\nStarting cleanup...\n";
@@ -40,5 +50,7 @@ auto main() -> int
             th.join();
     std::cout << "All jobs cleaned up.\n";
 
+    TRACE_DUMP("latch.trace.json");
+
     return 0;
 }
\ No newline at end of file
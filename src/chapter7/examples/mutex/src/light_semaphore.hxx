@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <semaphore>
+
+#include "spin.hxx"
+
+/// Counting semaphore that spins briefly before blocking.
+///
+/// The count lives in an atomic that may go negative, in which case its
+/// magnitude is the number of threads blocked on the inner
+/// `std::counting_semaphore`. Acquires that find the count positive (or
+/// become positive while spinning) never touch the inner semaphore, and
+/// releases only call into it when someone is actually blocked, so a busy
+/// producer/consumer pair hands off without kernel wake-ups.
+///
+/// Offers the same `acquire`/`try_acquire`/`release` interface as
+/// `std::counting_semaphore` plus `try_acquire_up_to` for taking several
+/// permits with a single RMW.
+class light_semaphore
+{
+public:
+
+    explicit
+    light_semaphore(std::ptrdiff_t desired = 0, unsigned spin_limit = 6) noexcept
+        : m_count{ desired }
+        , m_spin_limit{ spin_limit }
+        , m_blocked{ 0 }
+    { }
+
+    light_semaphore(const light_semaphore&) = delete;
+    auto operator= (const light_semaphore&) -> light_semaphore& = delete;
+
+    auto
+    try_acquire() noexcept -> bool
+    { return try_acquire_up_to(1) == 1; }
+
+    /// Takes up to `n` permits without blocking. Returns how many were taken.
+    auto
+    try_acquire_up_to(std::ptrdiff_t n) noexcept -> std::ptrdiff_t
+    {
+        auto count = m_count.load(std::memory_order_relaxed);
+        while (count > 0)
+        {
+            auto take = std::min(count, n);
+            if (m_count.compare_exchange_weak(count, count - take, std::memory_order_acquire, std::memory_order_relaxed))
+                return take;
+        }
+        return 0;
+    }
+
+    auto
+    acquire() noexcept -> void
+    {
+        auto bo = backoff{ m_spin_limit };
+        do
+        {
+            if (try_acquire())
+                return;
+        } while (bo.spin());
+
+        /// Register as a waiter; if a permit turned up meanwhile we own it.
+        if (m_count.fetch_sub(1, std::memory_order_acquire) > 0)
+            return;
+
+        m_blocked.fetch_add(1, std::memory_order_relaxed);
+        m_sema.acquire();
+    }
+
+    auto
+    release(std::ptrdiff_t update = 1) noexcept -> void
+    {
+        auto old = m_count.fetch_add(update, std::memory_order_release);
+        if (old < 0)
+            m_sema.release(std::min(-old, update));
+    }
+
+    /// Number of acquires that had to block in the kernel.
+    auto
+    blocked() const noexcept -> std::uint64_t
+    { return m_blocked.load(std::memory_order_relaxed); }
+
+private:
+
+    std::atomic<std::ptrdiff_t> m_count;
+    unsigned m_spin_limit;
+    std::atomic<std::uint64_t> m_blocked;
+    std::counting_semaphore<> m_sema { 0 };
+};
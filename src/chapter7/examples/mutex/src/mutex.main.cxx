@@ -3,23 +3,30 @@
 #include <map>
 #include <mutex>
 #include <sstream>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include "trace.hxx"
+
 using namespace std::literals;
 
-auto mx  = std::mutex{};
+auto mx  = traced_mutex<std::mutex>{ "mx" };
 auto map = std::map<int, long long>{};
 
 auto job = [](auto job_id)
 { 
+    TRACE_THREAD_NAME("job " + std::to_string(job_id));
+    TRACE_SCOPE("task", "job");
     std::this_thread::sleep_for(150ms);
     auto ss = std::stringstream{};
     ss << std::this_thread::get_id();
     auto thread_id = std::stoll(ss.str());
 
-    while (!mx.try_lock())
-        std::this_thread::sleep_for(150ms);
+    TRACE_WAIT("lock wait", "mx", [] {
+        while (!mx.try_lock())
+            std::this_thread::sleep_for(150ms);
+    }());
 
     map.insert({ job_id, thread_id });
     mx.unlock();
@@ -29,7 +36,8 @@ auto job = [](auto job_id)
 auto main() -> int
 {    
     auto thr_count { std::thread::hardware_concurrency() };
-    auto pool = std::vector<std::thread>(thr_count);
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
 
     /// Queue jobs
     for (auto i { 0u }; i < thr_count; ++i)
@@ -47,5 +55,7 @@ auto main() -> int
         std::cout << k << ": " << v << (i-- ? ", " : "");
     std::cout << " }" << std::endl;
 
+    TRACE_DUMP("mutex.trace.json");
+
     return 0;
 }
\ No newline at end of file
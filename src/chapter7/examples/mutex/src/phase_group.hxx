@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trace.hxx"
+#include "tree_barrier.hxx"
+
+/// Timing for one phase of a `phase_group::run()`.
+struct phase_stats
+{
+    std::chrono::nanoseconds wall;      ///< Barrier to barrier time
+    std::chrono::nanoseconds min_busy;  ///< Fastest worker's time in the phase body
+    std::chrono::nanoseconds max_busy;  ///< Slowest worker's time in the phase body
+    std::chrono::nanoseconds mean_busy;
+    std::size_t straggler;              ///< Id of the slowest worker
+
+    /// Slowest worker relative to the average; `1.0` is perfectly balanced.
+    constexpr auto
+    imbalance() const noexcept -> double
+    {
+        return mean_busy.count() > 0
+            ? static_cast<double>(max_busy.count()) / static_cast<double>(mean_busy.count())
+            : 1.0;
+    }
+};
+
+/// Fixed pool of workers that runs sequences of parallel phases.
+///
+/// Threads are created once, in the constructor, and live until the group is
+/// destroyed. Every phase is run by all workers and is separated from the next
+/// by a `tree_barrier`, so an iterative solver can call `run()` thousands of
+/// times without re-creating threads or paying for a central barrier counter.
+///
+/// The calling thread takes part in each barrier (as the last participant)
+/// but does no work; it records phase boundaries through the barrier's
+/// completion function, while each worker times its own phase body. This
+/// gives per-phase wall time and per-worker imbalance for finding stragglers.
+class phase_group
+{
+public:
+
+    /// A phase body, called once per worker with `(worker_id, worker_count)`.
+    using phase = std::function<void(std::size_t, std::size_t)>;
+
+    explicit
+    phase_group(std::size_t workers = std::thread::hardware_concurrency())
+        : m_workers{ workers ? workers : 1 }
+        , m_barrier{ m_workers + 1, clock{ this } }
+        , m_busy(m_workers)
+    {
+        m_pool.reserve(m_workers);
+        for (auto id = std::size_t{ 0 }; id < m_workers; ++id)
+            m_pool.emplace_back([this, id]() { _M_work(id); });
+    }
+
+    phase_group(const phase_group&) = delete;
+    auto operator= (const phase_group&) -> phase_group& = delete;
+
+    ~phase_group() noexcept
+    {
+        m_stop = true;
+        m_barrier.arrive_and_wait(m_workers);
+
+        for (auto& th : m_pool)
+            th.join();
+    }
+
+    constexpr auto
+    size() const noexcept -> std::size_t
+    { return m_workers; }
+
+    /// Runs `phases` in order on every worker and blocks until the last one
+    /// completes. Not reentrant; call from one thread at a time.
+    auto
+    run(const std::vector<phase>& phases) -> std::vector<phase_stats>
+    {
+        m_phases = &phases;
+        m_marks.assign(phases.size() + 1, {});
+        m_marked = 0;
+        for (auto& b : m_busy)
+            b.ns.assign(phases.size(), 0);
+
+        /// One barrier to start, then one after each phase.
+        for (auto i = std::size_t{ 0 }; i <= phases.size(); ++i)
+            TRACE_WAIT("barrier wait", "phase", m_barrier.arrive_and_wait(m_workers));
+
+        m_phases = nullptr;
+        return _M_report();
+    }
+
+private:
+
+    using steady = std::chrono::steady_clock;
+
+    /// Barrier completion: stamps the end of each episode.
+    struct clock
+    {
+        phase_group* self;
+
+        auto
+        operator() () const noexcept -> void
+        {
+            if (self->m_marked < self->m_marks.size())
+                self->m_marks[self->m_marked++] = steady::now();
+        }
+    };
+
+    /// Per-worker busy times, padded so workers don't share lines.
+    struct alignas(64) busy
+    { std::vector<std::chrono::nanoseconds::rep> ns; };
+
+    auto
+    _M_work(std::size_t id) -> void
+    {
+        TRACE_THREAD_NAME("worker " + std::to_string(id));
+        while (true)
+        {
+            TRACE_WAIT("barrier wait", "start", m_barrier.arrive_and_wait(id));
+            if (m_stop)
+                return;
+
+            const auto& phases = *m_phases;
+            for (auto p = std::size_t{ 0 }; p < phases.size(); ++p)
+            {
+                auto start = steady::now();
+                {
+                    TRACE_SCOPE("task", "phase");
+                    phases[p](id, m_workers);
+                }
+                m_busy[id].ns[p] = std::chrono::duration_cast<std::chrono::nanoseconds>(steady::now() - start).count();
+                TRACE_WAIT("barrier wait", "phase", m_barrier.arrive_and_wait(id));
+            }
+        }
+    }
+
+    auto
+    _M_report() const -> std::vector<phase_stats>
+    {
+        auto report = std::vector<phase_stats>{};
+        report.reserve(m_marks.size() - 1);
+
+        for (auto p = std::size_t{ 0 }; p + 1 < m_marks.size(); ++p)
+        {
+            auto min = m_busy[0].ns[p];
+            auto max = m_busy[0].ns[p];
+            auto sum = std::chrono::nanoseconds::rep{ 0 };
+            auto straggler = std::size_t{ 0 };
+
+            for (auto w = std::size_t{ 0 }; w < m_workers; ++w)
+            {
+                auto ns = m_busy[w].ns[p];
+                sum += ns;
+                min = std::min(min, ns);
+                if (ns > max)
+                {
+                    max = ns;
+                    straggler = w;
+                }
+            }
+
+            report.push_back(phase_stats{
+                std::chrono::duration_cast<std::chrono::nanoseconds>(m_marks[p + 1] - m_marks[p]),
+                std::chrono::nanoseconds{ min },
+                std::chrono::nanoseconds{ max },
+                std::chrono::nanoseconds{ sum / static_cast<std::chrono::nanoseconds::rep>(m_workers) },
+                straggler
+            });
+        }
+
+        return report;
+    }
+
+    std::size_t m_workers;
+    tree_barrier<clock> m_barrier;
+    std::vector<busy> m_busy;
+    std::vector<steady::time_point> m_marks;
+    std::size_t m_marked { 0 };
+    const std::vector<phase>* m_phases { nullptr };
+    bool m_stop { false };
+    std::vector<std::thread> m_pool;
+};
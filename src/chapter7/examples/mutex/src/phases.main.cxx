@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "phase_group.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args)
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+constexpr auto cells        = 1u << 20;
+constexpr auto iterations   = 200u;
+
+/// Splits `[0, n)` into `parts` contiguous blocks and returns block `i`.
+auto block(std::size_t n, std::size_t i, std::size_t parts) -> std::pair<std::size_t, std::size_t>
+{ return { n * i / parts, n * (i + 1) / parts }; }
+
+auto main() -> int
+{
+    auto thr_count = std::max(std::thread::hardware_concurrency(), 2u);
+
+    auto grid = std::vector<double>(cells, 1.0);
+    auto next = std::vector<double>(cells, 0.0);
+    auto partial = std::vector<double>(thr_count, 0.0);
+
+    /// A Jacobi style smoothing step, a reduction and a swap. Worker 0 is
+    /// given extra work in the first phase so it shows up as a straggler.
+    auto phases = std::vector<phase_group::phase>{
+        [&](std::size_t id, std::size_t n)
+        {
+            auto [first, last] = block(cells, id, n);
+            auto repeat = id == 0 ? 3 : 1;
+            for (auto r { 0 }; r < repeat; ++r)
+                for (auto i { std::max<std::size_t>(first, 1) }; i < std::min<std::size_t>(last, cells - 1); ++i)
+                    next[i] = (grid[i - 1] + grid[i] + grid[i + 1]) / 3.0;
+        },
+        [&](std::size_t id, std::size_t n)
+        {
+            auto [first, last] = block(cells, id, n);
+            partial[id] = std::accumulate(next.begin() + first, next.begin() + last, 0.0);
+        },
+        [&](std::size_t id, std::size_t n)
+        {
+            auto [first, last] = block(cells, id, n);
+            std::copy(next.begin() + first, next.begin() + last, grid.begin() + first);
+        }
+    };
+    auto names = std::vector<std::string>{ "smooth", "reduce", "copy" };
+
+    /// The pattern from `latch.main.cxx`/`barrier.main.cxx`: spawn a pool for
+    /// every phase and join it before the next.
+    auto [spawn_time, spawn_ok] = measure<>::execution([&]()
+    {
+        for (auto it { 0u }; it < iterations; ++it)
+            for (const auto& ph : phases)
+            {
+                auto pool = std::vector<std::thread>();
+                pool.reserve(thr_count);
+                for (auto id { 0u }; id < thr_count; ++id)
+                    pool.emplace_back(ph, id, thr_count);
+                for (auto& th : pool)
+                    th.join();
+            }
+        return true;
+    });
+
+    auto group = phase_group{ thr_count };
+    auto totals = std::vector<phase_stats>(phases.size(), phase_stats{ {}, {}, {}, {}, 0 });
+    auto stragglers = std::vector<std::vector<unsigned>>(phases.size(), std::vector<unsigned>(thr_count, 0));
+
+    auto [group_time, group_ok] = measure<>::execution([&]()
+    {
+        for (auto it { 0u }; it < iterations; ++it)
+        {
+            auto report = group.run(phases);
+            for (auto p = std::size_t{ 0 }; p < report.size(); ++p)
+            {
+                totals[p].wall      += report[p].wall;
+                totals[p].min_busy  += report[p].min_busy;
+                totals[p].max_busy  += report[p].max_busy;
+                totals[p].mean_busy += report[p].mean_busy;
+                ++stragglers[p][report[p].straggler];
+            }
+        }
+        return true;
+    });
+
+    (void) spawn_ok;
+    (void) group_ok;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Workers: " << thr_count << ", iterations: " << iterations << "\n";
+    std::cout << "Spawn threads per phase : " << spawn_time << " us\n";
+    std::cout << "phase_group             : " << group_time << " us\n\n";
+
+    std::cout << "+--------+------------+------------+------------+-----------+-----------+" << std::endl;
+    std::cout << "| Phase  |  Wall (us) |  Min (us)  |  Max (us)  | Imbalance | Straggler |" << std::endl;
+    std::cout << "+--------+------------+------------+------------+-----------+-----------+" << std::endl;
+
+    for (auto p = std::size_t{ 0 }; p < phases.size(); ++p)
+    {
+        auto us = [](auto ns) { return ns.count() / 1000.0 / iterations; };
+        auto straggler = std::distance(stragglers[p].begin(), std::ranges::max_element(stragglers[p]));
+
+        std::cout << "| " << std::setw(6) << names[p] << " | "
+                  << std::setw(10) << us(totals[p].wall) << " | "
+                  << std::setw(10) << us(totals[p].min_busy) << " | "
+                  << std::setw(10) << us(totals[p].max_busy) << " | "
+                  << std::setw(9) << totals[p].imbalance() << " | "
+                  << std::setw(9) << straggler << " |" << std::endl;
+    }
+    std::cout << "+--------+------------+------------+------------+-----------+-----------+" << std::endl;
+
+    TRACE_DUMP("phases.trace.json");
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "distributed_shared_mutex.hxx"
+#include "seqlock.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args)
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+constexpr auto ops_per_thread   = 500'000u;
+constexpr auto write_every      = 1'000u;   ///< One write per this many operations
+
+/// Small read-mostly state, e.g. a configuration or pricing snapshot.
+struct snapshot
+{
+    double bid;
+    double ask;
+    std::uint64_t volume;
+    std::uint64_t stamp;
+};
+
+/// Shared state guarded by a lock: readers use `Shared` lock type, writers
+/// `std::unique_lock`.
+template<typename Mutex, template<typename> typename Shared>
+struct guarded
+{
+    Mutex mx;
+    snapshot value{};
+
+    auto read() -> snapshot
+    {
+        auto lk = Shared<Mutex>{ mx };
+        return value;
+    }
+
+    auto write(const snapshot& s) -> void
+    {
+        auto lk = std::unique_lock{ mx };
+        value = s;
+    }
+};
+
+struct sequenced
+{
+    seqlock<snapshot> lk;
+
+    auto read() -> snapshot
+    { return lk.load(); }
+
+    auto write(const snapshot& s) -> void
+    { lk.store(s); }
+};
+
+template<typename State>
+auto run(State& state, unsigned thr_count) -> std::uint64_t
+{
+    auto sums = std::vector<std::uint64_t>(thr_count, 0);
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
+
+    for (auto t { 0u }; t < thr_count; ++t)
+        pool.emplace_back([&state, &sums, t]()
+        {
+            auto local = std::uint64_t{ 0 };
+            for (auto i { 1u }; i <= ops_per_thread; ++i)
+            {
+                if (i % write_every == 0)
+                    state.write(snapshot{ 1.0 * i, 1.0 * i + 0.5, i, t });
+                else
+                    local += state.read().volume;
+            }
+            sums[t] = local;
+        });
+
+    for (auto& th : pool)
+        th.join();
+
+    auto total = std::uint64_t{ 0 };
+    for (auto s : sums)
+        total += s;
+    return total;
+}
+
+template<typename State>
+auto report(const std::string& name, unsigned thr_count) -> void
+{
+    auto state = State{};
+    auto [time, result] = measure<>::execution([&](){ return run(state, thr_count); });
+    auto reads = static_cast<double>(thr_count) * ops_per_thread * (write_every - 1) / write_every;
+
+    std::cout << "| " << std::setw(7) << thr_count << " | " << std::left << std::setw(24) << name << std::right << " | "
+              << std::setw(9) << time << " us | " << std::setw(14) << reads / std::max<double>(time, 1) << " |" << std::endl;
+    (void) result;
+}
+
+auto main() -> int
+{
+    auto max_threads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "+---------+--------------------------+--------------+----------------+" << std::endl;
+    std::cout << "| Threads |           Lock           |     Time     |   Mreads/sec   |" << std::endl;
+    std::cout << "+---------+--------------------------+--------------+----------------+" << std::endl;
+
+    for (auto thr_count { 1u }; thr_count <= max_threads; ++thr_count)
+    {
+        report<guarded<std::mutex, std::unique_lock>>("std::mutex", thr_count);
+        report<guarded<std::shared_mutex, std::shared_lock>>("std::shared_mutex", thr_count);
+        report<guarded<distributed_shared_mutex, std::shared_lock>>("distributed_shared_mutex", thr_count);
+        report<sequenced>("seqlock", thr_count);
+        std::cout << "+---------+--------------------------+--------------+----------------+" << std::endl;
+    }
+
+    return 0;
+}
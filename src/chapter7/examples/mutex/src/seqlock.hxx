@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "spin.hxx"
+
+/// Sequence lock publishing small trivially copyable snapshots.
+///
+/// Readers never write shared memory: they read the sequence number, copy
+/// the value and retry if the sequence changed (or was odd, meaning a write
+/// was in progress). Writers serialise on the sequence number itself by
+/// moving it from even to odd with a CAS.
+///
+/// The payload is stored as relaxed atomic words rather than a raw `T` so a
+/// reader racing a writer is a retried read, not a data race.
+template<typename T>
+    requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class seqlock
+{
+public:
+
+    using value_type = T;
+
+    seqlock() noexcept
+        : seqlock(value_type{})
+    { }
+
+    explicit
+    seqlock(const value_type& value) noexcept
+        : m_seq{ 0 }
+    { _M_write(value); }
+
+    seqlock(const seqlock&) = delete;
+    auto operator= (const seqlock&) -> seqlock& = delete;
+
+    ~seqlock() noexcept = default;
+
+    /// Returns a consistent snapshot, retrying while a write is in flight.
+    auto
+    load() const noexcept -> value_type
+    {
+        while (true)
+        {
+            auto before = m_seq.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                cpu_relax();
+                continue;
+            }
+
+            auto value = _M_read();
+
+            /// Keep the payload reads from sinking below the second load.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_seq.load(std::memory_order_relaxed) == before)
+                return value;
+        }
+    }
+
+    auto
+    store(const value_type& value) noexcept -> void
+    {
+        auto seq = m_seq.load(std::memory_order_relaxed);
+        auto bo = backoff{};
+        while ((seq & 1) || !m_seq.compare_exchange_weak(seq, seq + 1, std::memory_order_relaxed))
+        {
+            if (!bo.spin())
+                bo.reset();
+            seq = m_seq.load(std::memory_order_relaxed);
+        }
+
+        /// Keep the payload writes from floating above the odd sequence.
+        std::atomic_thread_fence(std::memory_order_release);
+        _M_write(value);
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /// Number of completed writes.
+    auto
+    version() const noexcept -> std::uint64_t
+    { return m_seq.load(std::memory_order_acquire) / 2; }
+
+private:
+
+    static constexpr std::size_t word_count = (sizeof(value_type) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    using words = std::array<std::uint64_t, word_count>;
+
+    auto
+    _M_read() const noexcept -> value_type
+    {
+        auto buffer = words{};
+        for (auto i = std::size_t{ 0 }; i < word_count; ++i)
+            buffer[i] = m_data[i].load(std::memory_order_relaxed);
+
+        auto value = value_type{};
+        std::memcpy(&value, buffer.data(), sizeof(value_type));
+        return value;
+    }
+
+    auto
+    _M_write(const value_type& value) noexcept -> void
+    {
+        auto buffer = words{};
+        std::memcpy(buffer.data(), &value, sizeof(value_type));
+        for (auto i = std::size_t{ 0 }; i < word_count; ++i)
+            m_data[i].store(buffer[i], std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> m_seq;
+    std::array<std::atomic<std::uint64_t>, word_count> m_data;
+};
@@ -0,0 +1,431 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "epoch.hxx"
+#include "spin.hxx"
+
+/// Ordered concurrent map, a lazy skip list (Herlihy, Lev, Luchangco and
+/// Shavit).
+///
+/// Lookups and scans take no locks; they only load `next` pointers. Writers
+/// find the predecessors of their key at every level, lock just those nodes,
+/// check that nothing changed and link or unlink. Writers on different parts
+/// of the key space therefore never contend, unlike the single mutex around
+/// `std::map` in `locks`.
+///
+/// A node is in the map once `fully_linked` is set and until `marked` is
+/// set. Erased nodes are unlinked and then retired to `epoch_domain`, so
+/// readers still walking through them are safe. Every operation runs under
+/// an `epoch_guard`.
+///
+/// Iteration (`for_each`, `scan`) visits keys in order and is weakly
+/// consistent: it sees every key present for the whole scan, and may or may
+/// not see keys inserted or erased during it. Values must be trivially
+/// copyable so they can be updated in place atomically.
+template<typename K,
+         typename V,
+         typename Compare = std::less<K>,
+         std::size_t MaxLevel = 20>
+    requires std::is_trivially_copyable_v<V> && (MaxLevel >= 1 && MaxLevel <= 32)
+class skip_list
+{
+public:
+
+    using key_type      = K;
+    using mapped_type   = V;
+    using key_compare   = Compare;
+    using size_type     = std::size_t;
+
+    static constexpr size_type max_level = MaxLevel;
+
+    explicit
+    skip_list(Compare compare = Compare{})
+        : m_compare{ std::move(compare) }
+        , m_head{ node::create_head() }
+    { }
+
+    skip_list(const skip_list&) = delete;
+    auto operator= (const skip_list&) -> skip_list& = delete;
+
+    /// Not safe to run concurrently with any other operation.
+    ~skip_list() noexcept
+    {
+        auto* n = m_head->next(0).load(std::memory_order_relaxed);
+        while (n)
+        {
+            auto* next = n->next(0).load(std::memory_order_relaxed);
+            node::destroy(n);
+            n = next;
+        }
+        node::destroy(m_head);
+    }
+
+    auto
+    size() const noexcept -> size_type
+    { return m_size.load(std::memory_order_relaxed); }
+
+    auto
+    empty() const noexcept -> bool
+    { return size() == 0; }
+
+    auto
+    find(const K& key) const -> std::optional<V>
+    {
+        auto guard = epoch_guard{};
+        auto* pred = m_head;
+        for (auto level = max_level; level-- > 0; )
+        {
+            auto* curr = pred->next(level).load(std::memory_order_acquire);
+            while (curr && m_compare(curr->key, key))
+            {
+                pred = curr;
+                curr = pred->next(level).load(std::memory_order_acquire);
+            }
+            if (curr && !m_compare(key, curr->key))
+            {
+                if (curr->fully_linked.load(std::memory_order_acquire) && !curr->marked.load(std::memory_order_acquire))
+                    return curr->value.load(std::memory_order_acquire);
+                return std::nullopt;
+            }
+        }
+        return std::nullopt;
+    }
+
+    auto
+    contains(const K& key) const -> bool
+    { return find(key).has_value(); }
+
+    /// Inserts `key` or overwrites its value. Returns `true` if it was
+    /// inserted.
+    auto
+    insert_or_assign(const K& key, const V& value) -> bool
+    { return _M_insert(key, value, true); }
+
+    /// Inserts `key` only if it is absent. Returns `true` if it was inserted.
+    auto
+    insert(const K& key, const V& value) -> bool
+    { return _M_insert(key, value, false); }
+
+    /// Removes `key`. Returns `true` if this call removed it.
+    auto
+    erase(const K& key) -> bool
+    {
+        auto guard = epoch_guard{};
+        auto preds = node_array{};
+        auto succs = node_array{};
+        node* victim = nullptr;
+        auto height = std::size_t{ 0 };
+
+        while (true)
+        {
+            auto found = _M_find(key, preds, succs);
+
+            if (!victim)
+            {
+                if (found < 0)
+                    return false;
+
+                auto* candidate = succs[static_cast<std::size_t>(found)];
+                if (!candidate->fully_linked.load(std::memory_order_acquire)
+                    || candidate->height - 1 != static_cast<std::size_t>(found)
+                    || candidate->marked.load(std::memory_order_acquire))
+                    return false;
+
+                candidate->lock();
+                if (candidate->marked.load(std::memory_order_relaxed))
+                {
+                    candidate->unlock();
+                    return false;
+                }
+                candidate->marked.store(true, std::memory_order_release);
+                victim = candidate;
+                height = victim->height;
+            }
+
+            /// The victim is ours; unlink it once its predecessors are stable.
+            auto locked = _M_lock(preds, height, [&](node* pred, std::size_t level)
+            {
+                return !pred->marked.load(std::memory_order_acquire)
+                    && pred->next(level).load(std::memory_order_acquire) == victim;
+            });
+            if (!locked)
+                continue;
+
+            for (auto level = height; level-- > 0; )
+                preds[level]->next(level).store(victim->next(level).load(std::memory_order_relaxed), std::memory_order_release);
+
+            victim->unlock();
+            _M_unlock(preds, height);
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            epoch_domain::instance().retire(victim, &node::destroy_erased);
+            return true;
+        }
+    }
+
+    /// Calls `f(key, value)` for every key in `[lo, hi)`, in order. Returns
+    /// the number of keys visited.
+    template<typename F>
+    auto
+    scan(const K& lo, const K& hi, F f) const -> size_type
+    {
+        auto guard = epoch_guard{};
+        auto* pred = m_head;
+        node* curr = nullptr;
+        for (auto level = max_level; level-- > 0; )
+        {
+            curr = pred->next(level).load(std::memory_order_acquire);
+            while (curr && m_compare(curr->key, lo))
+            {
+                pred = curr;
+                curr = pred->next(level).load(std::memory_order_acquire);
+            }
+        }
+
+        /// Start from the node the descent stopped at; re-reading
+        /// `pred->next(0)` could find a key below `lo` inserted since.
+        return _M_walk(curr, &hi, f);
+    }
+
+    /// Calls `f(key, value)` for every key, in order. Returns the number of
+    /// keys visited.
+    template<typename F>
+    auto
+    for_each(F f) const -> size_type
+    {
+        auto guard = epoch_guard{};
+        return _M_walk(m_head->next(0).load(std::memory_order_acquire), nullptr, f);
+    }
+
+private:
+
+    struct alignas(std::atomic<void*>) node
+    {
+        std::atomic<bool> locked { false };
+        std::atomic<bool> marked { false };
+        std::atomic<bool> fully_linked { false };
+        std::size_t height;
+        K key;
+        std::atomic<V> value;
+
+        node(const K& k, const V& v, std::size_t h)
+            : height{ h }
+            , key{ k }
+            , value{ v }
+        { }
+
+        /// The head has every level and no meaningful key or value.
+        explicit
+        node(std::size_t h)
+            : height{ h }
+            , key{}
+            , value{}
+        { }
+
+        /// The `height` forward pointers live just after the node, in the
+        /// same allocation.
+        auto
+        next(std::size_t level) noexcept -> std::atomic<node*>&
+        { return reinterpret_cast<std::atomic<node*>*>(this + 1)[level]; }
+
+        static auto
+        bytes(std::size_t h) noexcept -> std::size_t
+        { return sizeof(node) + h * sizeof(std::atomic<node*>); }
+
+        template<typename... Args>
+        static auto
+        create(std::size_t h, Args&&... args) -> node*
+        {
+            auto* mem = ::operator new(bytes(h), std::align_val_t{ alignof(node) });
+            auto* n = ::new (mem) node(std::forward<Args>(args)..., h);
+            for (auto level = std::size_t{ 0 }; level < h; ++level)
+                ::new (&n->next(level)) std::atomic<node*>{ nullptr };
+            return n;
+        }
+
+        static auto
+        create_head() -> node*
+        {
+            auto* n = create(max_level);
+            n->fully_linked.store(true, std::memory_order_relaxed);
+            return n;
+        }
+
+        static auto
+        destroy(node* n) noexcept -> void
+        {
+            n->~node();
+            ::operator delete(n, std::align_val_t{ alignof(node) });
+        }
+
+        static auto
+        destroy_erased(void* n) -> void
+        { destroy(static_cast<node*>(n)); }
+
+        auto
+        lock() noexcept -> void
+        {
+            auto b = backoff{};
+            while (locked.exchange(true, std::memory_order_acquire))
+                while (locked.load(std::memory_order_relaxed))
+                    if (!b.spin())
+                        std::this_thread::yield();
+        }
+
+        auto
+        unlock() noexcept -> void
+        { locked.store(false, std::memory_order_release); }
+    };
+
+    using node_array = std::array<node*, max_level>;
+
+    /// Fills the predecessors and successors of `key` at every level.
+    /// Returns the highest level `key` was found at, or `-1`.
+    auto
+    _M_find(const K& key, node_array& preds, node_array& succs) const -> int
+    {
+        auto found = -1;
+        auto* pred = m_head;
+        for (auto level = max_level; level-- > 0; )
+        {
+            auto* curr = pred->next(level).load(std::memory_order_acquire);
+            while (curr && m_compare(curr->key, key))
+            {
+                pred = curr;
+                curr = pred->next(level).load(std::memory_order_acquire);
+            }
+            if (found < 0 && curr && !m_compare(key, curr->key))
+                found = static_cast<int>(level);
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return found;
+    }
+
+    /// Locks the distinct predecessors on levels `[0, height)` bottom up,
+    /// checking `valid(pred, level)` at each. On failure unlocks them again
+    /// and returns `false`.
+    template<typename Valid>
+    auto
+    _M_lock(const node_array& preds, std::size_t height, Valid valid) -> bool
+    {
+        node* prev = nullptr;
+        for (auto level = std::size_t{ 0 }; level < height; ++level)
+        {
+            if (preds[level] != prev)
+            {
+                preds[level]->lock();
+                prev = preds[level];
+            }
+            if (!valid(preds[level], level))
+            {
+                _M_unlock(preds, level + 1);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    auto
+    _M_unlock(const node_array& preds, std::size_t height) noexcept -> void
+    {
+        node* prev = nullptr;
+        for (auto level = std::size_t{ 0 }; level < height; ++level)
+            if (preds[level] != prev)
+            {
+                preds[level]->unlock();
+                prev = preds[level];
+            }
+    }
+
+    auto
+    _M_insert(const K& key, const V& value, bool assign) -> bool
+    {
+        auto guard = epoch_guard{};
+        auto preds = node_array{};
+        auto succs = node_array{};
+        auto height = _S_random_height();
+
+        while (true)
+        {
+            if (auto found = _M_find(key, preds, succs); found >= 0)
+            {
+                auto* existing = succs[static_cast<std::size_t>(found)];
+                if (existing->marked.load(std::memory_order_acquire))
+                    continue;   /// being erased; retry once it is gone
+
+                while (!existing->fully_linked.load(std::memory_order_acquire))
+                    cpu_relax();
+                if (assign)
+                    existing->value.store(value, std::memory_order_release);
+                return false;
+            }
+
+            auto locked = _M_lock(preds, height, [&](node* pred, std::size_t level)
+            {
+                auto* succ = succs[level];
+                return !pred->marked.load(std::memory_order_acquire)
+                    && (!succ || !succ->marked.load(std::memory_order_acquire))
+                    && pred->next(level).load(std::memory_order_acquire) == succ;
+            });
+            if (!locked)
+                continue;
+
+            auto* n = node::create(height, key, value);
+            for (auto level = std::size_t{ 0 }; level < height; ++level)
+                n->next(level).store(succs[level], std::memory_order_relaxed);
+            for (auto level = std::size_t{ 0 }; level < height; ++level)
+                preds[level]->next(level).store(n, std::memory_order_release);
+            n->fully_linked.store(true, std::memory_order_release);
+
+            _M_unlock(preds, height);
+            m_size.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    /// Walks level 0 from `n`, skipping nodes that are not (or no longer)
+    /// in the map, until `hi` (exclusive) or the end.
+    template<typename F>
+    auto
+    _M_walk(node* n, const K* hi, F& f) const -> size_type
+    {
+        auto visited = size_type{ 0 };
+        for (; n && (!hi || m_compare(n->key, *hi)); n = n->next(0).load(std::memory_order_acquire))
+        {
+            if (!n->fully_linked.load(std::memory_order_acquire) || n->marked.load(std::memory_order_acquire))
+                continue;
+            f(n->key, n->value.load(std::memory_order_acquire));
+            ++visited;
+        }
+        return visited;
+    }
+
+    /// Geometric with p = 1/2, capped at `max_level`.
+    static auto
+    _S_random_height() noexcept -> std::size_t
+    {
+        thread_local auto state = std::uint64_t{ 0x9e3779b97f4a7c15ULL }
+            ^ std::hash<std::thread::id>{}(std::this_thread::get_id());
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        auto h = static_cast<std::size_t>(std::countr_one(static_cast<std::uint32_t>(state))) + 1;
+        return std::min(h, max_level);
+    }
+
+    [[no_unique_address]] Compare m_compare;
+    node* m_head;
+    alignas(64) std::atomic<size_type> m_size { 0 };
+};
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "skip_list.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args)
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+constexpr auto key_range        = 1u << 18;
+constexpr auto ops_per_thread   = 100'000u;
+constexpr auto scan_width       = 64u;
+constexpr auto scans_per_thread = 10'000u;
+
+/// Cheap per-thread PRNG so key generation doesn't dominate the measurement.
+struct xorshift
+{
+    std::uint64_t state;
+
+    auto operator() () noexcept -> std::uint64_t
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+/// The registry from `locks.main.cxx`, with the operations of `skip_list`.
+struct locked_map
+{
+    std::mutex mx;
+    std::map<int, long long> map;
+
+    auto find(int k) -> std::optional<long long>
+    {
+        auto lk = std::lock_guard{ mx };
+        if (auto it = map.find(k); it != map.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    auto insert_or_assign(int k, long long v) -> bool
+    {
+        auto lk = std::lock_guard{ mx };
+        return map.insert_or_assign(k, v).second;
+    }
+
+    auto erase(int k) -> bool
+    {
+        auto lk = std::lock_guard{ mx };
+        return map.erase(k) != 0;
+    }
+
+    template<typename F>
+    auto scan(int lo, int hi, F f) -> std::size_t
+    {
+        auto lk = std::lock_guard{ mx };
+        auto n = std::size_t{ 0 };
+        for (auto it = map.lower_bound(lo); it != map.end() && it->first < hi; ++it, ++n)
+            f(it->first, it->second);
+        return n;
+    }
+
+    auto size() -> std::size_t
+    {
+        auto lk = std::lock_guard{ mx };
+        return map.size();
+    }
+
+    template<typename F>
+    auto for_each(F f) -> std::size_t
+    {
+        auto lk = std::lock_guard{ mx };
+        for (const auto& [k, v] : map)
+            f(k, v);
+        return map.size();
+    }
+};
+
+using ordered_map = skip_list<int, long long>;
+
+enum class workload { insert, lookup, mixed, scan };
+
+auto to_string(workload w) -> std::string
+{
+    switch (w)
+    {
+        case workload::insert: return "insert";
+        case workload::lookup: return "lookup";
+        case workload::mixed:  return "80/10/10";
+        default:               return "scan";
+    }
+}
+
+auto ops_for(workload w) -> unsigned
+{ return w == workload::scan ? scans_per_thread : ops_per_thread; }
+
+/// Every other key, so lookups hit half the time.
+template<typename Map>
+auto prefill(Map& map) -> void
+{
+    for (auto k { 0u }; k < key_range; k += 2)
+        map.insert_or_assign(static_cast<int>(k), static_cast<long long>(k));
+}
+
+/// Runs `thr_count` workers on `w`. Returns the number of keys found or
+/// scanned so the work can't be optimised away.
+///
+/// - `insert`: every thread inserts its own share of an empty map.
+/// - `lookup`: random finds.
+/// - `mixed`: 80% finds, 10% inserts and 10% erases.
+/// - `scan`: ordered range scans of `scan_width` keys.
+template<typename Map>
+auto run(Map& map, unsigned thr_count, workload w) -> std::size_t
+{
+    auto hits = std::vector<std::size_t>(thr_count, 0);
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
+
+    for (auto t { 0u }; t < thr_count; ++t)
+        pool.emplace_back([&map, &hits, t, thr_count, w]()
+        {
+            auto rng = xorshift{ 0x9e3779b97f4a7c15ULL * (t + 1) };
+            auto local = std::size_t{ 0 };
+            auto sum = 0ll;
+
+            for (auto i { 0u }; i < ops_for(w); ++i)
+            {
+                auto r = rng();
+                auto key = static_cast<int>(r % key_range);
+
+                switch (w)
+                {
+                    case workload::insert:
+                        /// A scattered permutation, so threads insert all over the key space.
+                        key = static_cast<int>((static_cast<std::uint64_t>(i * thr_count + t) * 0x9e3779b1u) % key_range);
+                        local += map.insert_or_assign(key, static_cast<long long>(r));
+                        break;
+                    case workload::lookup:
+                        local += map.find(key).has_value();
+                        break;
+                    case workload::mixed:
+                        if (auto dice = (r >> 32) % 10; dice < 8)
+                            local += map.find(key).has_value();
+                        else if (dice == 8)
+                            map.insert_or_assign(key, static_cast<long long>(r));
+                        else
+                            map.erase(key);
+                        break;
+                    case workload::scan:
+                        local += map.scan(key, key + static_cast<int>(scan_width), [&](int, long long v) { sum += v; });
+                        break;
+                }
+            }
+
+            hits[t] = local + static_cast<std::size_t>(sum & 1);
+        });
+
+    for (auto& th : pool)
+        th.join();
+
+    auto total = std::size_t{ 0 };
+    for (auto h : hits)
+        total += h;
+    return total;
+}
+
+/// Ordered contents, to check the skip list against `std::map`.
+template<typename Map>
+auto contents(Map& map) -> std::vector<std::pair<int, long long>>
+{
+    auto out = std::vector<std::pair<int, long long>>{};
+    map.for_each([&](int k, long long v) { out.emplace_back(k, v); });
+    return out;
+}
+
+auto main() -> int
+{
+    auto max_threads = std::max(std::thread::hardware_concurrency(), 2u);
+    auto thread_counts = std::vector<unsigned>{};
+    for (auto t { 1u }; t < max_threads; t *= 2)
+        thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "+----------+---------+--------------------+----------------+----------------+---------+" << std::endl;
+    std::cout << "| Workload | Threads |        Map         |      Time      |    Mops/sec    | Speedup |" << std::endl;
+    std::cout << "+----------+---------+--------------------+----------------+----------------+---------+" << std::endl;
+
+    for (auto w : { workload::insert, workload::lookup, workload::mixed, workload::scan })
+    {
+        for (auto thr_count : thread_counts)
+        {
+            auto total_ops = static_cast<double>(thr_count) * ops_for(w);
+
+            auto locked = locked_map{};
+            auto ordered = ordered_map{};
+            if (w != workload::insert)
+            {
+                prefill(locked);
+                prefill(ordered);
+            }
+
+            auto [locked_time, locked_hits] = measure<>::execution([&](){ return run(locked, thr_count, w); });
+            auto [list_time, list_hits] = measure<>::execution([&](){ return run(ordered, thr_count, w); });
+
+            /// Inserts write random values, but the keys must agree.
+            if (w == workload::insert || w == workload::lookup)
+            {
+                auto a = contents(locked);
+                auto b = contents(ordered);
+                auto same_keys = std::ranges::equal(a, b, {}, &std::pair<int, long long>::first, &std::pair<int, long long>::first);
+                if (!same_keys || ordered.size() != locked.size() || (w == workload::lookup && locked_hits != list_hits))
+                    std::cout << "| Mismatch: std::map " << locked.size() << " keys, skip_list " << ordered.size() << " keys" << std::endl;
+            }
+
+            std::cout << "| " << std::left << std::setw(8) << to_string(w) << std::right
+                      << " | " << std::setw(7) << thr_count
+                      << " | std::map + mutex   | " << std::setw(11) << locked_time << " us | "
+                      << std::setw(14) << total_ops / std::max<double>(locked_time, 1) << " |  " << std::setw(6) << 1.0 << " |" << std::endl;
+            std::cout << "| " << std::left << std::setw(8) << to_string(w) << std::right
+                      << " | " << std::setw(7) << thr_count
+                      << " | skip_list          | " << std::setw(11) << list_time << " us | "
+                      << std::setw(14) << total_ops / std::max<double>(list_time, 1) << " |  "
+                      << std::setw(6) << static_cast<double>(locked_time) / std::max<double>(list_time, 1) << " |" << std::endl;
+            std::cout << "+----------+---------+--------------------+----------------+----------------+---------+" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+#endif
+
+/// Hint to the CPU that we are in a spin-wait loop. On x86 `pause` stops the
+/// core speculating ahead of the loop and frees resources for its SMT sibling.
+inline auto
+cpu_relax() noexcept -> void
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/// Exponential backoff for spin-waits. Each call to `spin()` relaxes for
+/// twice as many iterations as the last, up to `limit` rounds, after which
+/// the caller should stop spinning and block.
+class backoff
+{
+public:
+
+    explicit constexpr
+    backoff(unsigned limit = 10) noexcept
+        : m_round{ 0 }
+        , m_limit{ limit }
+    { }
+
+    /// Spins for the current round. Returns `false` once the spin budget is
+    /// exhausted.
+    auto
+    spin() noexcept -> bool
+    {
+        if (m_round >= m_limit)
+            return false;
+
+        for (auto i { 1u << m_round }; i; --i)
+            cpu_relax();
+
+        ++m_round;
+        return true;
+    }
+
+    constexpr auto
+    rounds() const noexcept -> unsigned
+    { return m_round; }
+
+    constexpr auto
+    reset() noexcept -> void
+    { m_round = 0; }
+
+private:
+
+    unsigned m_round;
+    unsigned m_limit;
+};
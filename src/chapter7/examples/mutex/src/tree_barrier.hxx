@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "spin.hxx"
+
+/// Default completion function, does nothing (same as `std::barrier`'s).
+struct empty_completion
+{
+    constexpr auto
+    operator() () const noexcept -> void
+    { }
+};
+
+/// Combining-tree barrier with sense reversal.
+///
+/// `std::barrier` funnels every arrival through one counter, so on high core
+/// counts each phase serialises on a single cache line. Here participants
+/// arrive at a leaf shared with at most `Fanin - 1` others; the last arrival
+/// at a node carries the arrival up to its parent and the last arrival at the
+/// root runs the completion function and flips the global sense, releasing
+/// everyone. Contention per node is bounded by `Fanin` and the critical path
+/// is `log_Fanin(count)` RMWs.
+///
+/// Waiters spin with exponential backoff on the sense flag, yield a few
+/// times and then block on `std::atomic::wait`, so short phases never enter
+/// the kernel while long phases (or oversubscribed cores) don't burn cycles.
+///
+/// Unlike `std::barrier`, arrivals name their participant id (in
+/// `[0, count)`); that static mapping from participant to leaf is what
+/// removes the central counter. Each id must arrive exactly once per phase.
+template<std::invocable CompletionFunction = empty_completion, std::size_t Fanin = 4>
+    requires (Fanin >= 2) && std::is_nothrow_invocable_v<CompletionFunction&>
+class tree_barrier
+{
+public:
+
+    static constexpr unsigned backoff_limit = 8;
+
+    explicit
+    tree_barrier(std::size_t count,
+                 CompletionFunction completion = CompletionFunction{},
+                 unsigned spin_limit = backoff_limit)
+        : m_count{ count }
+        , m_spin_limit{ spin_limit }
+        , m_completion{ std::move(completion) }
+        , m_sense{ false }
+        , m_local{ std::make_unique<local_sense[]>(count) }
+    {
+        if (count == 0)
+            throw std::invalid_argument("Barrier Count Zero");
+
+        _M_build();
+    }
+
+    tree_barrier(const tree_barrier&) = delete;
+    auto operator= (const tree_barrier&) -> tree_barrier& = delete;
+
+    ~tree_barrier() noexcept = default;
+
+    /// Arrives as participant `id` and blocks until every participant has
+    /// arrived for the current phase.
+    auto
+    arrive_and_wait(std::size_t id) noexcept -> void
+    {
+        auto sense = !m_local[id].sense;
+        m_local[id].sense = sense;
+
+        auto* n = &m_nodes[id / Fanin];
+        while (n->count.fetch_add(1, std::memory_order_acq_rel) + 1 == n->expected)
+        {
+            /// Last to arrive here; no other participant touches this node
+            /// until the phase is released, so a plain reset is safe.
+            n->count.store(0, std::memory_order_relaxed);
+
+            if (n->parent == nullptr)
+            {
+                std::invoke(m_completion);
+                m_sense.store(sense, std::memory_order_release);
+                m_sense.notify_all();
+                return;
+            }
+
+            n = n->parent;
+        }
+
+        _M_wait(sense);
+    }
+
+    constexpr auto
+    count() const noexcept -> std::size_t
+    { return m_count; }
+
+    static constexpr auto
+    max() noexcept -> std::size_t
+    { return std::numeric_limits<std::uint32_t>::max(); }
+
+private:
+
+    static constexpr std::size_t cache_line = 64;
+
+    struct alignas(cache_line) node
+    {
+        std::atomic<std::uint32_t> count { 0 };
+        std::uint32_t expected { 0 };
+        node* parent { nullptr };
+    };
+
+    /// Each participant's sense is only touched by that participant, but
+    /// still padded so neighbours don't false share.
+    struct alignas(cache_line) local_sense
+    { bool sense { false }; };
+
+    /// Lays the tree out level by level, leaves first, so participant `id`
+    /// starts at node `id / Fanin`.
+    auto
+    _M_build() -> void
+    {
+        auto widths = std::vector<std::size_t>{};
+        auto width = (m_count + Fanin - 1) / Fanin;
+        widths.push_back(width);
+        while (width > 1)
+        {
+            width = (width + Fanin - 1) / Fanin;
+            widths.push_back(width);
+        }
+
+        auto total = std::size_t{ 0 };
+        for (auto w : widths)
+            total += w;
+        m_nodes = std::make_unique<node[]>(total);
+
+        auto level = std::size_t{ 0 };
+        auto below = m_count;
+        for (auto l = std::size_t{ 0 }; l < widths.size(); ++l)
+        {
+            auto above = level + widths[l];
+            for (auto i = std::size_t{ 0 }; i < widths[l]; ++i)
+            {
+                auto& n = m_nodes[level + i];
+                auto first = i * Fanin;
+                n.expected = static_cast<std::uint32_t>(std::min(Fanin, below - first));
+                n.parent = l + 1 < widths.size() ? &m_nodes[above + i / Fanin] : nullptr;
+            }
+            below = widths[l];
+            level = above;
+        }
+    }
+
+    /// Spin, then yield (cheap when threads outnumber cores), then park.
+    auto
+    _M_wait(bool sense) noexcept -> void
+    {
+        auto bo = backoff{ m_spin_limit };
+        auto yields = 0u;
+        while (m_sense.load(std::memory_order_acquire) != sense)
+        {
+            if (bo.spin())
+                continue;
+
+            if (yields++ < yield_limit)
+                std::this_thread::yield();
+            else
+                m_sense.wait(!sense, std::memory_order_acquire);
+        }
+    }
+
+    static constexpr unsigned yield_limit = 16;
+
+    std::size_t m_count;
+    unsigned m_spin_limit;
+    [[no_unique_address]] CompletionFunction m_completion;
+    alignas(cache_line) std::atomic<bool> m_sense;
+    std::unique_ptr<local_sense[]> m_local;
+    std::unique_ptr<node[]> m_nodes;
+};
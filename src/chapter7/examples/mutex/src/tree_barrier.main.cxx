@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <barrier>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tree_barrier.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args)
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+constexpr auto episodes = 20'000u;
+
+/// Counts completed phases, the same way an iterative solver might bump its
+/// iteration number.
+struct phase_counter
+{
+    std::uint64_t* phases;
+
+    auto operator() () const noexcept -> void
+    { ++*phases; }
+};
+
+/// Runs `thr_count` threads through `episodes` barrier phases. `arrive` is
+/// called with the barrier and the worker's id.
+template<typename Barrier, typename Arrive>
+auto run(Barrier& barrier, unsigned thr_count, Arrive arrive) -> bool
+{
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
+
+    for (auto t { 0u }; t < thr_count; ++t)
+        pool.emplace_back([&barrier, &arrive, t]()
+        {
+            for (auto e { 0u }; e < episodes; ++e)
+                arrive(barrier, t);
+        });
+
+    for (auto& th : pool)
+        th.join();
+
+    return true;
+}
+
+auto main() -> int
+{
+    auto max_threads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "+---------+--------------+-------------+-------------------+" << std::endl;
+    std::cout << "| Threads |   Barrier    |    Time     |   Episodes/sec    |" << std::endl;
+    std::cout << "+---------+--------------+-------------+-------------------+" << std::endl;
+
+    for (auto thr_count { 1u }; thr_count <= max_threads; thr_count = thr_count < max_threads && thr_count * 2 > max_threads ? max_threads : thr_count * 2)
+    {
+        auto std_phases = std::uint64_t{ 0 };
+        auto std_barrier = std::barrier{ static_cast<std::ptrdiff_t>(thr_count), phase_counter{ &std_phases } };
+        auto [std_time, std_ok] = measure<>::execution([&](){
+            return run(std_barrier, thr_count, [](auto& b, auto){ b.arrive_and_wait(); });
+        });
+
+        auto tree_phases = std::uint64_t{ 0 };
+        auto tree = tree_barrier<phase_counter>{ thr_count, phase_counter{ &tree_phases } };
+        auto [tree_time, tree_ok] = measure<>::execution([&](){
+            return run(tree, thr_count, [](auto& b, auto id){ b.arrive_and_wait(id); });
+        });
+
+        std::cout << "| " << std::setw(7) << thr_count << " | std::barrier | " << std::setw(8) << std_time << " us | "
+                  << std::setw(17) << std_phases * 1'000'000.0 / std::max<double>(std_time, 1) << " |" << std::endl;
+        std::cout << "| " << std::setw(7) << thr_count << " | tree_barrier | " << std::setw(8) << tree_time << " us | "
+                  << std::setw(17) << tree_phases * 1'000'000.0 / std::max<double>(tree_time, 1) << " |" << std::endl;
+        std::cout << "+---------+--------------+-------------+-------------------+" << std::endl;
+
+        (void) std_ok;
+        (void) tree_ok;
+
+        if (thr_count == max_threads)
+            break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <semaphore>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "light_semaphore.hxx"
+#include "spin.hxx"
+
+/// Bounded multi-producer/multi-consumer work queue built on two counting
+/// semaphores: `slots` counts free cells and `items` counts filled ones.
+///
+/// Producers block while the queue is full and consumers while it is empty,
+/// but a consumer can take up to `k` items per wake-up with `pop_batch`,
+/// amortising one semaphore acquire (and, if it blocked, one kernel wake)
+/// over the batch.
+///
+/// The semaphores bound how many cells are in use; which cell each thread
+/// uses is claimed with a ticket, and a per-cell sequence number (as in
+/// Vyukov's bounded queue) covers the short window where a ticket's cell is
+/// still being written or read by the previous lap.
+template<typename T, typename Semaphore = light_semaphore>
+    requires std::is_nothrow_move_constructible_v<T>
+class work_queue
+{
+public:
+
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    explicit
+    work_queue(size_type capacity)
+        : m_mask{ std::bit_ceil(capacity < 2 ? size_type{ 2 } : capacity) - 1 }
+        , m_cells{ std::make_unique<cell[]>(m_mask + 1) }
+        , m_slots{ static_cast<std::ptrdiff_t>(m_mask + 1) }
+        , m_items{ 0 }
+    {
+        for (auto i = size_type{ 0 }; i <= m_mask; ++i)
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    work_queue(const work_queue&) = delete;
+    auto operator= (const work_queue&) -> work_queue& = delete;
+
+    ~work_queue() noexcept
+    {
+        /// Destroy anything still queued.
+        auto head = m_head.load(std::memory_order_relaxed);
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        for (; head != tail; ++head)
+            _M_value(m_cells[head & m_mask]).~value_type();
+    }
+
+    constexpr auto
+    capacity() const noexcept -> size_type
+    { return m_mask + 1; }
+
+    /// Blocks while the queue is full.
+    template<typename... Args>
+    auto
+    push(Args&&... args) -> void
+    {
+        m_slots.acquire();
+        _M_put(std::forward<Args>(args)...);
+        m_items.release();
+    }
+
+    /// Blocks while the queue is empty.
+    auto
+    pop() -> value_type
+    {
+        m_items.acquire();
+        auto value = _M_take();
+        m_slots.release();
+        return value;
+    }
+
+    /// Blocks until at least one item is available, then moves up to `k`
+    /// items to `out`. Returns the number of items taken.
+    template<typename OutputIt>
+    auto
+    pop_batch(OutputIt out, size_type k) -> size_type
+    {
+        m_items.acquire();
+        auto taken = std::ptrdiff_t{ 1 } + _M_try_acquire_items(static_cast<std::ptrdiff_t>(k) - 1);
+
+        for (auto i = std::ptrdiff_t{ 0 }; i < taken; ++i)
+            *out++ = _M_take();
+
+        m_slots.release(taken);
+        return static_cast<size_type>(taken);
+    }
+
+    auto
+    items() const noexcept -> const Semaphore&
+    { return m_items; }
+
+private:
+
+    static constexpr size_type cache_line = 64;
+
+    struct cell
+    {
+        std::atomic<std::uint64_t> seq;
+        alignas(value_type) std::byte storage[sizeof(value_type)];
+    };
+
+    static auto
+    _M_value(cell& c) noexcept -> value_type&
+    { return *std::launder(reinterpret_cast<value_type*>(c.storage)); }
+
+    auto
+    _M_try_acquire_items(std::ptrdiff_t n) noexcept -> std::ptrdiff_t
+    {
+        if (n <= 0)
+            return 0;
+
+        if constexpr (requires (Semaphore& s) { s.try_acquire_up_to(n); })
+            return m_items.try_acquire_up_to(n);
+        else
+        {
+            auto taken = std::ptrdiff_t{ 0 };
+            while (taken < n && m_items.try_acquire())
+                ++taken;
+            return taken;
+        }
+    }
+
+    /// Called holding a slot permit.
+    template<typename... Args>
+    auto
+    _M_put(Args&&... args) -> void
+    {
+        auto ticket = m_tail.fetch_add(1, std::memory_order_relaxed);
+        auto& c = m_cells[ticket & m_mask];
+
+        auto bo = backoff{};
+        while (c.seq.load(std::memory_order_acquire) != ticket)
+            if (!bo.spin())
+                std::this_thread::yield();
+
+        ::new (static_cast<void*>(c.storage)) value_type(std::forward<Args>(args)...);
+        c.seq.store(ticket + 1, std::memory_order_release);
+    }
+
+    /// Called holding an item permit.
+    auto
+    _M_take() noexcept -> value_type
+    {
+        auto ticket = m_head.fetch_add(1, std::memory_order_relaxed);
+        auto& c = m_cells[ticket & m_mask];
+
+        auto bo = backoff{};
+        while (c.seq.load(std::memory_order_acquire) != ticket + 1)
+            if (!bo.spin())
+                std::this_thread::yield();
+
+        auto& slot = _M_value(c);
+        auto value = value_type(std::move(slot));
+        slot.~value_type();
+        c.seq.store(ticket + m_mask + 1, std::memory_order_release);
+        return value;
+    }
+
+    size_type m_mask;
+    std::unique_ptr<cell[]> m_cells;
+    alignas(cache_line) std::atomic<std::uint64_t> m_tail { 0 };
+    alignas(cache_line) std::atomic<std::uint64_t> m_head { 0 };
+    alignas(cache_line) Semaphore m_slots;
+    alignas(cache_line) Semaphore m_items;
+};
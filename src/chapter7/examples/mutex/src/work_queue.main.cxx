@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "light_semaphore.hxx"
+#include "work_queue.hxx"
+
+constexpr auto total_items  = 2'000'000u;
+constexpr auto handoffs     = 100'000u;
+constexpr auto capacity     = 1024u;
+
+struct result
+{
+    double seconds;
+    std::uint64_t wakes;    ///< Consumer calls that returned at least one item
+    std::uint64_t blocked;  ///< Consumer acquires that blocked in the kernel, if known
+};
+
+/// The pattern from `semaphores.main.cxx`: one item per round trip through a
+/// pair of binary semaphores. `std::binary_semaphore` does not report whether
+/// an acquire blocked, so this row has no blocked count.
+auto handoff() -> result
+{
+    auto to_consumer = std::binary_semaphore{ 0 };
+    auto to_producer = std::binary_semaphore{ 0 };
+    auto item = std::uint64_t{ 0 };
+    auto sum = std::uint64_t{ 0 };
+
+    auto start = std::chrono::steady_clock::now();
+    auto consumer = std::thread{ [&]()
+    {
+        for (auto i { 0u }; i < handoffs; ++i)
+        {
+            to_consumer.acquire();
+            sum += item;
+            to_producer.release();
+        }
+    } };
+
+    for (auto i { 0u }; i < handoffs; ++i)
+    {
+        item = i;
+        to_consumer.release();
+        to_producer.acquire();
+    }
+    consumer.join();
+
+    (void) sum;
+    return result{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), handoffs, 0 };
+}
+
+template<typename Semaphore>
+auto run(unsigned producers, unsigned consumers, std::size_t batch) -> result
+{
+    auto queue = work_queue<std::uint64_t, Semaphore>{ capacity };
+    auto wakes = std::vector<std::uint64_t>(consumers, 0);
+    auto per_consumer = total_items / consumers;
+    auto per_producer = total_items / producers;
+
+    auto start = std::chrono::steady_clock::now();
+    auto pool = std::vector<std::thread>();
+    pool.reserve(producers + consumers);
+
+    for (auto c { 0u }; c < consumers; ++c)
+        pool.emplace_back([&, c]()
+        {
+            auto buffer = std::vector<std::uint64_t>(batch);
+            auto sum = std::uint64_t{ 0 };
+            for (auto got = std::size_t{ 0 }; got < per_consumer; ++wakes[c])
+            {
+                auto n = queue.pop_batch(buffer.begin(), std::min(batch, per_consumer - got));
+                for (auto i = std::size_t{ 0 }; i < n; ++i)
+                    sum += buffer[i];
+                got += n;
+            }
+            (void) sum;
+        });
+
+    for (auto p { 0u }; p < producers; ++p)
+        pool.emplace_back([&]()
+        {
+            for (auto i { 0u }; i < per_producer; ++i)
+                queue.push(i);
+        });
+
+    for (auto& th : pool)
+        th.join();
+
+    auto res = result{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 0, 0 };
+    for (auto w : wakes)
+        res.wakes += w;
+    if constexpr (std::is_same_v<Semaphore, light_semaphore>)
+        res.blocked = queue.items().blocked();
+    return res;
+}
+
+auto print(const std::string& name, std::size_t batch, std::uint64_t items, const result& r, bool known_blocks) -> void
+{
+    std::cout << "| " << std::left << std::setw(26) << name << std::right << " | " << std::setw(5) << batch << " | "
+              << std::setw(10) << items / r.seconds / 1e6 << " | "
+              << std::setw(10) << static_cast<double>(r.wakes) / items << " | ";
+    if (known_blocks)
+        std::cout << std::setw(12) << static_cast<double>(r.blocked) / items << " |" << std::endl;
+    else
+        std::cout << "           - |" << std::endl;
+}
+
+auto main() -> int
+{
+    auto producers = std::max(std::thread::hardware_concurrency() / 2, 1u);
+    auto consumers = producers;
+
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "Producers: " << producers << ", consumers: " << consumers << ", capacity: " << capacity << "\n";
+    std::cout << "+----------------------------+-------+------------+------------+--------------+" << std::endl;
+    std::cout << "|           Queue            | Batch | Mitems/sec | Wakes/item | Blocked/item |" << std::endl;
+    std::cout << "+----------------------------+-------+------------+------------+--------------+" << std::endl;
+
+    print("binary_semaphore handoff", 1, handoffs, handoff(), false);
+    std::cout << "+----------------------------+-------+------------+------------+--------------+" << std::endl;
+
+    for (auto batch : { std::size_t{ 1 }, std::size_t{ 8 }, std::size_t{ 32 }, std::size_t{ 128 } })
+    {
+        print("work_queue<counting_sema>", batch, total_items, run<std::counting_semaphore<>>(producers, consumers, batch), false);
+        print("work_queue<light_sema>", batch, total_items, run<light_semaphore>(producers, consumers, batch), true);
+        std::cout << "+----------------------------+-------+------------+------------+--------------+" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <tbb/version.h>
+
+/// Persistent benchmark results and a statistical comparison of two runs.
+///
+/// A `result_store` collects every repetition of every measurement, keyed
+/// by algorithm and execution policy, together with metadata describing
+/// the machine and the build, and saves it as a tab-separated text file:
+///
+///     meta    <key>       <value>
+///     result  <algorithm> <policy>    <unit>  <sample> <sample> ...
+///
+/// `compare_results` pairs the measurements of two files and runs a
+/// Mann-Whitney U test on each pair's samples. Unlike comparing means or
+/// best times it makes no assumption about the shape of the timing
+/// distribution and is robust to the odd outlier, so a change is only
+/// reported when the two sets of repetitions are genuinely shifted.
+
+/// Compiler flags cannot be recovered from inside the program. Define
+/// `BENCH_FLAGS` to the build's flags to record them exactly; otherwise the
+/// predefined macros that the flags switch on are recorded instead.
+#ifndef BENCH_FLAGS
+#   define BENCH_FLAGS ""
+#endif
+
+struct result_key
+{
+    std::string algorithm;
+    std::string policy;
+
+    auto operator<=> (const result_key&) const = default;
+};
+
+struct result_series
+{
+    std::string unit;
+    std::vector<double> samples;
+};
+
+class result_store
+{
+public:
+
+    using metadata_type = std::map<std::string, std::string>;
+    using series_type   = std::map<result_key, result_series>;
+
+    result_store() = default;
+
+    /// A store pre-filled with the metadata of this machine and build.
+    static auto
+    for_this_run() -> result_store
+    {
+        auto store = result_store{};
+        auto& m = store.m_metadata;
+
+        char host[256] = {};
+        ::gethostname(host, sizeof(host) - 1);
+        m["host"] = host;
+        m["cpu"] = _S_cpu_model();
+        m["hardware_threads"] = std::to_string(std::thread::hardware_concurrency());
+        m["compiler"] = _S_compiler();
+        m["flags"] = _S_flags();
+        m["tbb"] = std::to_string(TBB_VERSION_MAJOR) + "." + std::to_string(TBB_VERSION_MINOR);
+        m["timestamp"] = std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+                             std::chrono::system_clock::now().time_since_epoch()).count());
+        return store;
+    }
+
+    auto
+    set_metadata(std::string key, std::string value) -> void
+    { m_metadata[std::move(key)] = std::move(value); }
+
+    auto
+    metadata() const noexcept -> const metadata_type&
+    { return m_metadata; }
+
+    /// Appends samples to the series for `(algorithm, policy)`.
+    auto
+    add(std::string algorithm, std::string policy, std::string unit, const std::vector<double>& samples) -> void
+    {
+        auto& s = m_series[result_key{ std::move(algorithm), std::move(policy) }];
+        s.unit = std::move(unit);
+        s.samples.insert(s.samples.end(), samples.begin(), samples.end());
+    }
+
+    auto
+    series() const noexcept -> const series_type&
+    { return m_series; }
+
+    auto
+    save(const std::string& path) const -> void
+    {
+        auto os = std::ofstream{ path };
+        if (!os)
+            throw std::runtime_error("Cannot Open Results File: " + path);
+
+        os.precision(17);
+        for (const auto& [k, v] : m_metadata)
+            os << "meta\t" << _S_clean(k) << '\t' << _S_clean(v) << '\n';
+        for (const auto& [k, s] : m_series)
+        {
+            os << "result\t" << _S_clean(k.algorithm) << '\t' << _S_clean(k.policy) << '\t' << _S_clean(s.unit);
+            for (auto x : s.samples)
+                os << '\t' << x;
+            os << '\n';
+        }
+    }
+
+    static auto
+    load(const std::string& path) -> result_store
+    {
+        auto is = std::ifstream{ path };
+        if (!is)
+            throw std::runtime_error("Cannot Open Results File: " + path);
+
+        auto store = result_store{};
+        auto line = std::string{};
+        while (std::getline(is, line))
+        {
+            if (line.empty())
+                continue;
+
+            auto fields = _S_split(line);
+            if (fields[0] == "meta" && fields.size() == 3)
+                store.m_metadata[fields[1]] = fields[2];
+            else if (fields[0] == "result" && fields.size() >= 4)
+            {
+                auto samples = std::vector<double>{};
+                for (auto i = std::size_t{ 4 }; i < fields.size(); ++i)
+                    samples.push_back(std::stod(fields[i]));
+                store.add(fields[1], fields[2], fields[3], samples);
+            }
+            else
+                throw std::runtime_error("Malformed Results Line: " + line);
+        }
+        return store;
+    }
+
+private:
+
+    static auto
+    _S_clean(std::string s) -> std::string
+    {
+        std::ranges::replace(s, '\t', ' ');
+        std::ranges::replace(s, '\n', ' ');
+        return s;
+    }
+
+    /// Splits on every tab, keeping empty fields, including a trailing one
+    /// (an empty metadata value or unit).
+    static auto
+    _S_split(const std::string& line) -> std::vector<std::string>
+    {
+        auto fields = std::vector<std::string>{};
+        auto start = std::size_t{ 0 };
+        for (auto tab = line.find('\t'); tab != std::string::npos; tab = line.find('\t', start))
+        {
+            fields.push_back(line.substr(start, tab - start));
+            start = tab + 1;
+        }
+        fields.push_back(line.substr(start));
+        return fields;
+    }
+
+    static auto
+    _S_cpu_model() -> std::string
+    {
+        auto is = std::ifstream{ "/proc/cpuinfo" };
+        auto line = std::string{};
+        while (std::getline(is, line))
+            if (line.starts_with("model name"))
+                if (auto colon = line.find(':'); colon != std::string::npos)
+                    return line.substr(std::min(colon + 2, line.size()));
+        return "unknown";
+    }
+
+    static auto
+    _S_compiler() -> std::string
+    {
+#if defined(__clang__)
+        return std::string{ "clang " } + __clang_version__;
+#elif defined(__GNUC__)
+        return std::string{ "gcc " } + __VERSION__;
+#else
+        return "unknown";
+#endif
+    }
+
+    static auto
+    _S_flags() -> std::string
+    {
+        if (std::string_view{ BENCH_FLAGS }.size())
+            return BENCH_FLAGS;
+
+        auto flags = std::string{ "c++" } + std::to_string(__cplusplus);
+#if defined(__OPTIMIZE__)
+        flags += " optimize";
+#endif
+#if defined(__FAST_MATH__)
+        flags += " fast-math";
+#endif
+#if defined(__AVX512F__)
+        flags += " avx512f";
+#elif defined(__AVX2__)
+        flags += " avx2";
+#elif defined(__AVX__)
+        flags += " avx";
+#endif
+#if defined(__FMA__)
+        flags += " fma";
+#endif
+#if defined(NDEBUG)
+        flags += " ndebug";
+#endif
+        return flags;
+    }
+
+    metadata_type m_metadata;
+    series_type m_series;
+};
+
+/// Result of a two-sided Mann-Whitney U test.
+struct mann_whitney
+{
+    double u;           ///< U statistic of the first sample
+    double z;           ///< normal approximation of U
+    double p_value;     ///< two-sided
+};
+
+/// Two-sided Mann-Whitney U test with the normal approximation, corrected
+/// for ties and continuity. The approximation is adequate from about eight
+/// samples per side; with fewer, small p-values should not be trusted.
+inline auto
+mann_whitney_u(const std::vector<double>& a, const std::vector<double>& b) -> mann_whitney
+{
+    auto n1 = static_cast<double>(a.size());
+    auto n2 = static_cast<double>(b.size());
+    if (a.empty() || b.empty())
+        return mann_whitney{ 0.0, 0.0, 1.0 };
+
+    /// Ranks of the pooled samples, ties sharing their mean rank.
+    auto pooled = std::vector<std::pair<double, bool>>{};
+    pooled.reserve(a.size() + b.size());
+    for (auto x : a) pooled.emplace_back(x, true);
+    for (auto x : b) pooled.emplace_back(x, false);
+    std::ranges::sort(pooled, {}, &std::pair<double, bool>::first);
+
+    auto rank_sum_a = 0.0;
+    auto tie_term = 0.0;
+    for (auto i = std::size_t{ 0 }; i < pooled.size(); )
+    {
+        auto j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first)
+            ++j;
+
+        auto rank = (static_cast<double>(i + 1) + static_cast<double>(j)) / 2.0;
+        for (auto k = i; k < j; ++k)
+            if (pooled[k].second)
+                rank_sum_a += rank;
+
+        auto t = static_cast<double>(j - i);
+        tie_term += t * t * t - t;
+        i = j;
+    }
+
+    auto u = rank_sum_a - n1 * (n1 + 1.0) / 2.0;
+    auto mean = n1 * n2 / 2.0;
+    auto n = n1 + n2;
+    auto variance = n1 * n2 / 12.0 * ((n + 1.0) - tie_term / (n * (n - 1.0)));
+    if (variance <= 0.0)
+        return mann_whitney{ u, 0.0, 1.0 };
+
+    auto diff = std::abs(u - mean);
+    auto z = std::max(diff - 0.5, 0.0) / std::sqrt(variance);
+    return mann_whitney{ u, u < mean ? -z : z, std::erfc(z / std::sqrt(2.0)) };
+}
+
+inline auto
+median(std::vector<double> v) -> double
+{
+    if (v.empty())
+        return 0.0;
+    auto mid = v.begin() + static_cast<std::ptrdiff_t>(v.size() / 2);
+    std::ranges::nth_element(v, mid);
+    if (v.size() % 2)
+        return *mid;
+    return (*mid + *std::ranges::max_element(v.begin(), mid)) / 2.0;
+}
+
+enum class verdict { unchanged, improved, regressed, missing };
+
+inline auto
+to_string(verdict v) noexcept -> std::string_view
+{
+    switch (v)
+    {
+        case verdict::improved:  return "improved";
+        case verdict::regressed: return "REGRESSED";
+        case verdict::missing:   return "missing";
+        default:                 return "unchanged";
+    }
+}
+
+struct comparison
+{
+    result_key key;
+    double base_median;
+    double candidate_median;
+    double change_percent;      ///< positive is slower, for time units
+    double p_value;
+    verdict outcome;
+};
+
+/// Compares every series present in either store. A series is flagged when
+/// the shift is significant at `alpha` and the medians differ by more than
+/// `threshold_percent`; larger is taken to be worse.
+inline auto
+compare_results(const result_store& base, const result_store& candidate, double threshold_percent = 5.0, double alpha = 0.05) -> std::vector<comparison>
+{
+    auto out = std::vector<comparison>{};
+
+    for (const auto& [key, b] : base.series())
+    {
+        auto it = candidate.series().find(key);
+        if (it == candidate.series().end())
+        {
+            out.push_back(comparison{ key, median(b.samples), 0.0, 0.0, 1.0, verdict::missing });
+            continue;
+        }
+
+        const auto& c = it->second;
+        auto bm = median(b.samples);
+        auto cm = median(c.samples);
+        auto change = bm != 0.0 ? 100.0 * (cm - bm) / bm : 0.0;
+        auto test = mann_whitney_u(b.samples, c.samples);
+
+        auto outcome = verdict::unchanged;
+        if (test.p_value < alpha && std::abs(change) > threshold_percent)
+            outcome = change > 0.0 ? verdict::regressed : verdict::improved;
+
+        out.push_back(comparison{ key, bm, cm, change, test.p_value, outcome });
+    }
+
+    for (const auto& [key, c] : candidate.series())
+        if (!base.series().contains(key))
+            out.push_back(comparison{ key, 0.0, median(c.samples), 0.0, 1.0, verdict::missing });
+
+    return out;
+}
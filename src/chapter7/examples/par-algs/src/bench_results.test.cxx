@@ -0,0 +1,60 @@
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_results.hxx"
+
+/// Saves a store and loads it back, including the empty fields a naive
+/// tab split drops: an empty metadata value and an empty unit.
+
+auto failures = 0;
+
+auto check(bool ok, const std::string& what) -> void
+{
+    if (!ok)
+    {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+auto main() -> int
+{
+    auto path = (std::filesystem::temp_directory_path() / "bench_results.test.tsv").string();
+
+    auto store = result_store{};
+    store.set_metadata("host", "bench-01");
+    store.set_metadata("flags", "");
+    store.set_metadata("note", "has\ta tab");
+    store.add("std::reduce", "par", "us", { 1.5, 2.25, 0.1 });
+    store.add("std::sort", "seq", "", { 3.0 });
+    store.add("std::scan", "", "us", {});
+    store.save(path);
+
+    auto loaded = result_store::load(path);
+    std::remove(path.c_str());
+
+    const auto& m = loaded.metadata();
+    check(m.size() == 3, "metadata count");
+    check(m.contains("host") && m.at("host") == "bench-01", "metadata value");
+    check(m.contains("flags") && m.at("flags").empty(), "empty metadata value");
+    check(m.contains("note") && m.at("note") == "has a tab", "tab in metadata value");
+
+    const auto& s = loaded.series();
+    check(s.size() == 3, "series count");
+
+    auto reduce = s.find(result_key{ "std::reduce", "par" });
+    check(reduce != s.end() && reduce->second.unit == "us"
+          && reduce->second.samples == std::vector<double>{ 1.5, 2.25, 0.1 }, "samples");
+
+    auto sort = s.find(result_key{ "std::sort", "seq" });
+    check(sort != s.end() && sort->second.unit.empty()
+          && sort->second.samples == std::vector<double>{ 3.0 }, "empty unit");
+
+    auto scan = s.find(result_key{ "std::scan", "" });
+    check(scan != s.end() && scan->second.unit == "us" && scan->second.samples.empty(), "empty policy, no samples");
+
+    return failures == 0 ? 0 : 1;
+}
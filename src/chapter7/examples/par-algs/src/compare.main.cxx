@@ -0,0 +1,78 @@
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+
+#include "bench_results.hxx"
+
+/// Usage: compare <base results> <candidate results> [threshold %] [alpha]
+///
+/// Diffs two saved runs per algorithm and policy. A change is flagged when
+/// the Mann-Whitney test finds the repetitions shifted at `alpha` (default
+/// 0.05) and the medians differ by more than the threshold (default 5%).
+/// Exits with status 2 when anything regressed.
+
+auto main(int argc, char* argv[]) -> int
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <base results> <candidate results> [threshold %] [alpha]" << std::endl;
+        return 1;
+    }
+
+    auto threshold = argc > 3 ? std::strtod(argv[3], nullptr) : 5.0;
+    auto alpha = argc > 4 ? std::strtod(argv[4], nullptr) : 0.05;
+
+    try
+    {
+        auto base = result_store::load(argv[1]);
+        auto candidate = result_store::load(argv[2]);
+
+        /// Metadata that differs between the runs, e.g. a compiler upgrade.
+        auto keys = std::set<std::string>{};
+        for (const auto& [k, v] : base.metadata()) keys.insert(k);
+        for (const auto& [k, v] : candidate.metadata()) keys.insert(k);
+
+        std::cout << "Metadata" << std::endl;
+        for (const auto& k : keys)
+        {
+            auto b = base.metadata().contains(k) ? base.metadata().at(k) : "-";
+            auto c = candidate.metadata().contains(k) ? candidate.metadata().at(k) : "-";
+            std::cout << "  " << std::left << std::setw(17) << k << b;
+            if (b != c)
+                std::cout << "  ->  " << c;
+            std::cout << std::endl;
+        }
+        std::cout << std::right << std::endl;
+
+        auto line = "+--------------------------+-------------+--------------+--------------+----------+----------+-----------+";
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << line << std::endl;
+        std::cout << "|        Algorithm         | Exec Policy | Base Median  |  New Median  |  Change  | p-value  |  Verdict  |" << std::endl;
+        std::cout << line << std::endl;
+
+        auto regressions = 0;
+        for (const auto& c : compare_results(base, candidate, threshold, alpha))
+        {
+            std::cout << "| " << std::left << std::setw(24) << c.key.algorithm
+                      << " | " << std::setw(11) << c.key.policy << std::right
+                      << " | " << std::setw(12) << c.base_median
+                      << " | " << std::setw(12) << c.candidate_median
+                      << " | " << std::showpos << std::setw(7) << c.change_percent << std::noshowpos << "%"
+                      << " | " << std::setw(8) << std::setprecision(4) << c.p_value << std::setprecision(2)
+                      << " | " << std::left << std::setw(9) << to_string(c.outcome) << std::right << " |" << std::endl;
+            regressions += c.outcome == verdict::regressed;
+        }
+        std::cout << line << std::endl;
+
+        std::cout << regressions << " regression(s) above " << threshold << "% at alpha " << alpha << std::endl;
+        return regressions ? 2 : 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/// Parallel, reproducible generation of benchmark inputs.
+///
+/// Values come from Philox4x32-10, a counter-based generator: the random
+/// bits for element `i` are a pure function of `(seed, i)`, so there is no
+/// generator state to carry from one element to the next. Every fill cuts
+/// its output into chunks and generates them with the parallel algorithms,
+/// and the result is bit-identical whatever the thread count or schedule.
+
+/// Philox4x32 with 10 rounds (Salmon et al., "Parallel Random Numbers: As
+/// Easy as 1, 2, 3", SC'11). Maps a 128-bit counter to 128 random bits
+/// under a 64-bit key.
+class philox4x32
+{
+public:
+
+    using counter_type = std::array<std::uint32_t, 4>;
+    using result_type  = std::array<std::uint32_t, 4>;
+
+    explicit constexpr
+    philox4x32(std::uint64_t seed) noexcept
+        : m_key{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) }
+    { }
+
+    constexpr auto
+    operator() (counter_type ctr) const noexcept -> result_type
+    {
+        auto key = m_key;
+        for (auto round = 0; round < 10; ++round)
+        {
+            auto p0 = std::uint64_t{ mul0 } * ctr[0];
+            auto p1 = std::uint64_t{ mul1 } * ctr[2];
+            ctr = {
+                static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+                static_cast<std::uint32_t>(p1),
+                static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+                static_cast<std::uint32_t>(p0)
+            };
+            key[0] += weyl0;
+            key[1] += weyl1;
+        }
+        return ctr;
+    }
+
+    /// Random bits for block `block` of stream `stream`.
+    constexpr auto
+    operator() (std::uint64_t block, std::uint32_t stream = 0, std::uint32_t attempt = 0) const noexcept -> result_type
+    { return (*this)(counter_type{ static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(block >> 32), stream, attempt }); }
+
+private:
+
+    static constexpr std::uint32_t mul0  = 0xD2511F53;
+    static constexpr std::uint32_t mul1  = 0xCD9E8D57;
+    static constexpr std::uint32_t weyl0 = 0x9E3779B9;
+    static constexpr std::uint32_t weyl1 = 0xBB67AE85;
+
+    std::array<std::uint32_t, 2> m_key;
+};
+
+namespace data_gen_detail
+{
+    /// Blocks generated per parallel work item.
+    inline constexpr auto chunk_blocks = std::size_t{ 4096 };
+
+    inline constexpr auto
+    join(std::uint32_t hi, std::uint32_t lo) noexcept -> std::uint64_t
+    { return (std::uint64_t{ hi } << 32) | lo; }
+
+    /// Uniform in [0, 1) with the full precision of `T`.
+    template <std::floating_point T>
+    constexpr auto
+    unit(std::uint64_t bits) noexcept -> T
+    {
+        constexpr auto digits = std::numeric_limits<T>::digits;
+        return static_cast<T>(bits >> (64 - digits)) * (T{ 1 } / static_cast<T>(std::uint64_t{ 1 } << digits));
+    }
+
+    /// Uniform integer in [0, range) by multiply-shift (Lemire). The bias is
+    /// at most `range / 2^64`, far below what a benchmark can notice.
+    inline constexpr auto
+    below(std::uint64_t bits, std::uint64_t range) noexcept -> std::uint64_t
+    { return static_cast<std::uint64_t>((static_cast<unsigned __int128>(bits) * range) >> 64); }
+
+    /// Fills `out` block by block: `make(bits, block)` turns the 128 random
+    /// bits of a block into `PerBlock` consecutive values.
+    template <std::size_t PerBlock, typename T, typename Make>
+    auto
+    fill_blocks(std::span<T> out, std::uint64_t seed, std::uint32_t stream, Make make) -> void
+    {
+        auto gen = philox4x32{ seed };
+        auto n = out.size();
+        auto blocks = (n + PerBlock - 1) / PerBlock;
+
+        /// Chunk indices go in a vector: the parallel algorithms run a
+        /// `std::views::iota` range on the calling thread.
+        auto chunks = std::vector<std::size_t>((blocks + chunk_blocks - 1) / chunk_blocks);
+        std::iota(chunks.begin(), chunks.end(), std::size_t{ 0 });
+
+        std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](std::size_t c)
+        {
+            auto last = std::min(blocks, (c + 1) * chunk_blocks);
+            for (auto b = c * chunk_blocks; b < last; ++b)
+            {
+                auto values = make(gen(b, stream), b);
+                auto first = b * PerBlock;
+                auto count = std::min(PerBlock, n - first);
+                std::copy_n(values.begin(), count, out.begin() + static_cast<std::ptrdiff_t>(first));
+            }
+        });
+    }
+
+    /// Distinct streams keep the distributions independent under one seed.
+    enum stream : std::uint32_t { uniform_stream = 1, normal_stream, zipf_stream, sorted_stream };
+}
+
+/// Uniform values: integers in `[lo, hi]`, floating-point in `[lo, hi)`.
+template <typename T>
+    requires std::is_arithmetic_v<T>
+auto
+fill_uniform(std::span<T> out, T lo, T hi, std::uint64_t seed) -> void
+{
+    using namespace data_gen_detail;
+
+    if (hi < lo)
+        throw std::invalid_argument("Empty Range");
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        auto width = hi - lo;
+        fill_blocks<2>(out, seed, uniform_stream, [=](const auto& r, auto)
+        {
+            return std::array<T, 2>{ lo + width * unit<T>(join(r[0], r[1])),
+                                     lo + width * unit<T>(join(r[2], r[3])) };
+        });
+    }
+    else
+    {
+        using U = std::make_unsigned_t<T>;
+        /// Wraps to 0 when the range is every value of a 64-bit type.
+        auto range = std::uint64_t{ static_cast<U>(static_cast<U>(hi) - static_cast<U>(lo)) } + 1;
+        auto pick = [=](std::uint64_t bits)
+        { return static_cast<T>(static_cast<U>(lo) + static_cast<U>(range ? below(bits, range) : bits)); };
+
+        fill_blocks<2>(out, seed, uniform_stream, [=](const auto& r, auto)
+        { return std::array<T, 2>{ pick(join(r[0], r[1])), pick(join(r[2], r[3])) }; });
+    }
+}
+
+/// Normally distributed values (Box-Muller: one block gives two).
+template <std::floating_point T>
+auto
+fill_normal(std::span<T> out, T mean, T stddev, std::uint64_t seed) -> void
+{
+    using namespace data_gen_detail;
+
+    fill_blocks<2>(out, seed, normal_stream, [=](const auto& r, auto)
+    {
+        /// `u1` in (0, 1] so the log is finite.
+        auto u1 = 1.0 - unit<double>(join(r[0], r[1]));
+        auto u2 = unit<double>(join(r[2], r[3]));
+        auto radius = std::sqrt(-2.0 * std::log(u1));
+        auto angle = 2.0 * std::numbers::pi * u2;
+        return std::array<T, 2>{ static_cast<T>(mean + stddev * radius * std::cos(angle)),
+                                 static_cast<T>(mean + stddev * radius * std::sin(angle)) };
+    });
+}
+
+/// Zipf-distributed ranks in `[1, n]`: rank `k` has probability
+/// proportional to `1 / k^s`, as in skewed key popularity. Uses Hörmann and
+/// Derflinger's rejection-inversion, which needs no table, so `n` can be
+/// huge; a rejected draw retries with the next `attempt` of the same
+/// counter, keeping every element independent.
+template <typename T>
+    requires std::is_arithmetic_v<T>
+auto
+fill_zipf(std::span<T> out, std::uint64_t n, double s, std::uint64_t seed) -> void
+{
+    using namespace data_gen_detail;
+
+    if (n == 0 || s <= 0.0)
+        throw std::invalid_argument("Invalid Zipf Parameters");
+
+    /// `H` is an antiderivative of `h(x) = x^-s`; `H_inv` its inverse. `t`
+    /// is clamped at -1, where rounding could otherwise push `log1p` out of
+    /// its domain and yield NaN.
+    auto H = [s](double x)
+    {
+        auto log_x = std::log(x);
+        auto t = (1.0 - s) * log_x;
+        return std::abs(t) > 1e-8 ? std::expm1(t) / (1.0 - s) : log_x * (1.0 + t / 2.0);
+    };
+    auto H_inv = [s](double y)
+    {
+        auto t = std::max(y * (1.0 - s), -1.0);
+        auto l = std::abs(t) > 1e-8 ? std::log1p(t) / (1.0 - s) : y * (1.0 - t / 2.0);
+        return std::exp(l);
+    };
+    auto h = [s](double x) { return std::exp(-s * std::log(x)); };
+
+    auto h_x1 = H(1.5) - 1.0;
+    auto h_n = H(static_cast<double>(n) + 0.5);
+    auto squeeze = 2.0 - H_inv(H(2.5) - h(2.0));
+    auto gen = philox4x32{ seed };
+
+    fill_blocks<1>(out, seed, zipf_stream, [=](const auto& first, std::uint64_t block)
+    {
+        auto r = first;
+        for (auto attempt = std::uint32_t{ 1 }; ; ++attempt)
+        {
+            auto u = h_n + unit<double>(join(r[0], r[1])) * (h_x1 - h_n);
+            auto x = H_inv(u);
+            auto k = std::clamp(std::floor(x + 0.5), 1.0, static_cast<double>(n));
+            if (k - x <= squeeze || u >= H(k + 0.5) - h(k))
+                return std::array<T, 1>{ static_cast<T>(k) };
+            r = gen(block, zipf_stream, attempt);
+        }
+    });
+}
+
+/// Sorted uniform values, ascending, or descending when `descending` is
+/// set. Element `i` of `n` is drawn uniformly from the `i`-th of `n` equal
+/// strata of the range, so the output comes out sorted without a sort and
+/// every element is still generated independently.
+template <typename T>
+    requires std::is_arithmetic_v<T>
+auto
+fill_sorted(std::span<T> out, T lo, T hi, std::uint64_t seed, bool descending = false) -> void
+{
+    using namespace data_gen_detail;
+
+    if (hi < lo)
+        throw std::invalid_argument("Empty Range");
+
+    auto n = out.size();
+    auto rank = [=](std::uint64_t i) { return descending ? n - 1 - i : i; };
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        auto width = hi - lo;
+        auto pick = [=](std::uint64_t bits, std::uint64_t i)
+        { return static_cast<T>(lo + width * ((static_cast<double>(rank(i)) + unit<double>(bits)) / static_cast<double>(n))); };
+
+        fill_blocks<2>(out, seed, sorted_stream, [=](const auto& r, std::uint64_t b)
+        { return std::array<T, 2>{ pick(join(r[0], r[1]), 2 * b), pick(join(r[2], r[3]), 2 * b + 1) }; });
+    }
+    else
+    {
+        using U = std::make_unsigned_t<T>;
+        using wide = unsigned __int128;
+        auto range = wide{ static_cast<U>(static_cast<U>(hi) - static_cast<U>(lo)) } + 1;
+
+        /// Position `rank * range + r` with `r` uniform in `[0, range)`,
+        /// scaled back down by `n`.
+        auto pick = [=](std::uint64_t bits, std::uint64_t i)
+        {
+            auto r = (wide{ bits } * range) >> 64;
+            return static_cast<T>(static_cast<U>(lo) + static_cast<U>((wide{ rank(i) } * range + r) / n));
+        };
+
+        fill_blocks<2>(out, seed, sorted_stream, [=](const auto& r, std::uint64_t b)
+        { return std::array<T, 2>{ pick(join(r[0], r[1]), 2 * b), pick(join(r[2], r[3]), 2 * b + 1) }; });
+    }
+}
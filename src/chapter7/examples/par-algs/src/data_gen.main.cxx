@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "data_gen.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args)
+        -> typename time_t::rep
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return duration.count();
+    }
+};
+
+static constexpr auto seed = std::uint64_t{ 42 };
+static const auto line = "+-------------------------------+-------------+------------+-------------+----------------+";
+
+/// Prints the time and throughput of one fill, plus the mean of the result
+/// as a sanity check.
+template <typename T, typename F>
+auto row(const char* name, const char* policy, std::vector<T>& v, F fill) -> void
+{
+    std::cout << "| " << std::left << std::setw(29) << name << std::right << " | " << policy << " | ";
+    auto time = measure<>::execution(fill, std::span{ v });
+    auto mean = std::reduce(std::execution::par_unseq, v.begin(), v.end(), 0.0) / static_cast<double>(v.size());
+    std::cout << std::setw(7) << time << " us | "
+              << std::setw(7) << static_cast<double>(v.size()) / static_cast<double>(time) << " M/s | "
+              << std::setw(14) << mean << " |" << std::endl;
+    std::cout << line << std::endl;
+}
+
+auto main() -> int
+{
+    auto v = std::vector<double>(100'000'007);
+    auto k = std::vector<std::uint32_t>(100'000'007);
+    std::cout.imbue(std::locale("en_US.UTF-8"));
+    std::cout << std::fixed << std::setprecision(3);
+
+    std::cout << line << std::endl;
+    std::cout << "|         Distribution          | Exec Policy |    Time    | Throughput  |      Mean      |" << std::endl;
+    std::cout << line << std::endl;
+
+    row("std::fill              0.1  ", "  Serial   ", v, [](auto out) { std::fill(out.begin(), out.end(), 0.1); });
+    row("mt19937_64 uniform  [0, 0.2)", "  Serial   ", v, [](auto out)
+    {
+        auto gen = std::mt19937_64{ seed };
+        auto dist = std::uniform_real_distribution<double>{ 0.0, 0.2 };
+        std::ranges::generate(out, [&]() { return dist(gen); });
+    });
+    row("mt19937_64 normal  (0.1, 1) ", "  Serial   ", v, [](auto out)
+    {
+        auto gen = std::mt19937_64{ seed };
+        auto dist = std::normal_distribution<double>{ 0.1, 1.0 };
+        std::ranges::generate(out, [&]() { return dist(gen); });
+    });
+    row("philox uniform      [0, 0.2)", " Parallel  ", v, [](auto out) { fill_uniform(out, 0.0, 0.2, seed); });
+    row("philox normal      (0.1, 1) ", " Parallel  ", v, [](auto out) { fill_normal(out, 0.1, 1.0, seed); });
+    row("philox sorted       [0, 0.2)", " Parallel  ", v, [](auto out) { fill_sorted(out, 0.0, 0.2, seed); });
+    row("philox reverse      [0, 0.2)", " Parallel  ", v, [](auto out) { fill_sorted(out, 0.0, 0.2, seed, true); });
+    row("philox uniform u32 [0, 2^32)", " Parallel  ", k, [](auto out) { fill_uniform(out, 0u, ~0u, seed); });
+    row("philox zipf u32  n=1M, s=1.1", " Parallel  ", k, [](auto out) { fill_zipf(out, 1'000'000, 1.1, seed); });
+
+    return 0;
+}
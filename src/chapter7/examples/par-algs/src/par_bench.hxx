@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bench_results.hxx"
+#include "roofline.hxx"
+
+/// Timing harness of the per-algorithm examples (`reduce`,
+/// `transform_reduce` and the four scans).
+///
+/// Every table row runs its kernel `repeats` times and reports the median.
+/// All repetitions are kept in a `result_store` and written by `save()` to
+/// the results file given on the command line (default
+/// `<benchmark>-<unix time>.tsv`), so two runs can be diffed with `compare`.
+///
+/// The constructor also measures the machine's peak bandwidth with the
+/// STREAM probe of `roofline.hxx`, before the example allocates its inputs,
+/// so each row can report its GB/s and how close it came to that peak.
+class par_bench
+{
+public:
+
+    static constexpr auto repeats = std::size_t{ 10 };
+
+    /// Doubles per STREAM array; large enough to miss every cache.
+    static constexpr auto probe_elements = std::size_t{ 1 } << 24;
+
+    /// Every example takes `[results file]` as its only argument.
+    par_bench(std::string_view benchmark, int argc, char* argv[])
+        : m_store{ result_store::for_this_run() }
+    {
+        m_path = argc > 1 ? std::string{ argv[1] } : std::string{ benchmark } + "-" + m_store.metadata().at("timestamp") + ".tsv";
+        m_store.set_metadata("benchmark", std::string{ benchmark });
+
+        auto threads = allowed_cpus().size();
+        m_roof = roofline::from(probe_bandwidth(probe_elements, threads), {}, threads);
+        m_store.set_metadata("peak_gb_per_s", std::to_string(m_roof.peak_gb_per_s));
+    }
+
+    /// Runs `func(args...)` `repeats` times and records every time under
+    /// `(algorithm, policy)`. Returns the median time in microseconds, paired
+    /// with the last run's result when `func` returns one.
+    template <typename F, typename... Args>
+    auto
+    execution(std::string_view algorithm, std::string_view policy, F func, Args&&... args)
+    {
+        using result_type = std::invoke_result_t<F, Args&...>;
+
+        auto samples = std::vector<double>{};
+        samples.reserve(repeats);
+        auto time = [&](auto&& run)
+        {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        };
+
+        if constexpr (std::is_void_v<result_type>)
+        {
+            for (auto r = std::size_t{ 0 }; r < repeats; ++r)
+                time([&] { std::invoke(func, args...); });
+            return _M_record(algorithm, policy, samples);
+        }
+        else
+        {
+            auto result = result_type{};
+            for (auto r = std::size_t{ 0 }; r < repeats; ++r)
+                time([&] { result = std::invoke(func, args...); });
+            return std::pair{ _M_record(algorithm, policy, samples), result };
+        }
+    }
+
+    /// The "GB/s" and "% of Peak" cells of a row whose run moved `bytes` in
+    /// `time_us`, each with its trailing separator.
+    auto
+    roofline_cells(double bytes, std::chrono::microseconds::rep time_us) const -> std::string
+    {
+        auto p = m_roof.position(bytes, 0.0, static_cast<double>(time_us));
+        auto os = std::ostringstream{};
+        os << std::fixed << std::setprecision(2)
+           << " " << std::setw(8) << p.gb_per_s << " |"
+           << " " << std::setw(8) << p.percent_of_bandwidth << "% |";
+        return os.str();
+    }
+
+    auto
+    save() const -> void
+    { m_store.save(m_path); }
+
+    auto
+    path() const noexcept -> const std::string&
+    { return m_path; }
+
+private:
+
+    auto
+    _M_record(std::string_view algorithm, std::string_view policy, const std::vector<double>& samples) -> std::chrono::microseconds::rep
+    {
+        m_store.add(std::string{ algorithm }, std::string{ policy }, "us", samples);
+        return static_cast<std::chrono::microseconds::rep>(std::llround(median(samples)));
+    }
+
+    result_store m_store;
+    std::string m_path;
+    roofline m_roof { 0.0, 0.0 };
+};
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "data_gen.hxx"
+#include "radix_sort.hxx"
+
+template <typename time_t = std::chrono::microseconds>
+struct measure
+{
+    template <typename F, typename... Args>
+    static auto execution(F func, Args&&... args)
+        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::invoke(func, std::forward<Args>(args)...);
+        auto duration = std::chrono::duration_cast<time_t>(std::chrono::steady_clock::now() - start);
+        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
+    }
+};
+
+static constexpr auto size = std::size_t{ 10'000'019 };
+static const auto line = std::string{ "+-----------------+-------------+-----------+------------+--------+" };
+
+template <typename T>
+auto random_keys() -> std::vector<T>
+{
+    auto v = std::vector<T>(size);
+
+    if constexpr (std::is_floating_point_v<T>)
+        fill_normal(std::span{ v }, T{ 0 }, T{ 1'000 }, 42);
+    else
+        fill_uniform(std::span{ v }, std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), 42);
+
+    return v;
+}
+
+/// Times `sort` on a fresh copy of `input` and prints one table row.
+/// Sortedness is checked after the clock stops.
+template <typename T, typename F>
+auto row(const char* algorithm, const char* policy, const char* type, const std::vector<T>& input, F sort) -> void
+{
+    auto v = input;
+    std::cout << "| " << algorithm << " | " << policy << " | " << type << " | ";
+    auto [time, n] = measure<>::execution([&]() { sort(v); return v.size(); });
+    std::cout << std::setw(7) << time << " us | " << (std::is_sorted(v.begin(), v.end()) && n == size ? "  ok  " : " FAIL ") << " |" << std::endl;
+    std::cout << line << std::endl;
+}
+
+template <typename T>
+auto compare(const char* type) -> void
+{
+    auto input = random_keys<T>();
+
+    row("   std::sort   ", "Sequencial ", type, input, [](auto& v) { std::sort(std::execution::seq, v.begin(), v.end()); });
+    row("   std::sort   ", " Parallel  ", type, input, [](auto& v) { std::sort(std::execution::par, v.begin(), v.end()); });
+    row("   std::sort   ", " Par-Unseq ", type, input, [](auto& v) { std::sort(std::execution::par_unseq, v.begin(), v.end()); });
+    row("  radix_sort   ", " Parallel  ", type, input, [](auto& v) { radix_sort(v); });
+}
+
+auto main() -> int
+{
+    std::cout.imbue(std::locale("en_US.UTF-8"));
+    std::cout << "Elements: " << size << std::endl;
+
+    std::cout << line << std::endl;
+    std::cout << "|    Algorithm    | Exec Policy |   Type    |    Time    | Result |" << std::endl;
+    std::cout << line << std::endl;
+
+    compare<std::uint32_t>(" uint32_t");
+    compare<std::int64_t>("  int64_t");
+    compare<float>("  float  ");
+    compare<double>("  double ");
+
+    /// Key/value: sort 32-bit keys carrying a 32-bit payload. `std::sort`
+    /// has to sort pairs; the radix sort moves the payload alongside.
+    auto keys = random_keys<std::uint32_t>();
+    auto pairs = std::vector<std::pair<std::uint32_t, std::uint32_t>>(size);
+    for (auto i = std::size_t{ 0 }; i < size; ++i)
+        pairs[i] = { keys[i], static_cast<std::uint32_t>(i) };
+
+    row("   std::sort   ", "Sequencial ", "key/value", pairs, [](auto& v) { std::sort(std::execution::seq, v.begin(), v.end()); });
+    row("   std::sort   ", " Par-Unseq ", "key/value", pairs, [](auto& v) { std::sort(std::execution::par_unseq, v.begin(), v.end()); });
+    row("  radix_sort   ", " Parallel  ", "key/value", pairs, [](auto& v)
+    {
+        auto ks = std::vector<std::uint32_t>(v.size());
+        auto vs = std::vector<std::uint32_t>(v.size());
+        for (auto i = std::size_t{ 0 }; i < v.size(); ++i)
+            std::tie(ks[i], vs[i]) = v[i];
+
+        radix_sort(std::span{ ks }, std::span{ vs });
+
+        for (auto i = std::size_t{ 0 }; i < v.size(); ++i)
+            v[i] = { ks[i], vs[i] };
+    });
+
+    return 0;
+}
@@ -1,60 +1,57 @@
 #include <algorithm>
-#include <chrono>
 #include <execution>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
+#include <span>
 #include <utility>
 #include <vector>
 
-template <typename time_t = std::chrono::microseconds>
-struct measure
-{
-    template <typename F, typename... Args>
-    static auto execution(F func, Args&&... args) 
-        -> std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>
-    {
-        auto start = std::chrono::system_clock::now();
-        auto result = std::invoke(func, std::forward<Args>(args)...);
-        auto duration = std::chrono::duration_cast<time_t>(std::chrono::system_clock::now() - start);
-        return std::pair<typename time_t::rep, std::invoke_result_t<F, Args...>>{ duration.count(), result };
-    }
-};
-
-auto main() -> int
+#include "data_gen.hxx"
+#include "par_bench.hxx"
+
+auto main(int argc, char* argv[]) -> int
 {
-    auto v = std::vector<double>(100'000'007, 0.1);
+    auto bench = par_bench{ "reduce", argc, argv };
+
+    auto v = std::vector<double>(100'000'007);
+    fill_uniform(std::span{ v }, 0.0, 0.2, 42);
+    /// Bytes each run moves: the input read once.
+    auto bytes = 8.0 * static_cast<double>(v.size());
     std::cout.imbue(std::locale("en_US.UTF-8"));
     std::cout << std::fixed << std::setprecision(1);
     
-    std::cout << "+-----------------+-------------+-----------+--------+------------+----------------+" << std::endl;
-    std::cout << "|    Algorithm    | Exec Policy | Binary-Op |  Type  |    Time    |     Result     |" << std::endl;
-    std::cout << "+-----------------+-------------+-----------+--------+------------+----------------+" << std::endl;
+    std::cout << "+-----------------+-------------+-----------+--------+------------+----------+-----------+----------------+" << std::endl;
+    std::cout << "|    Algorithm    | Exec Policy | Binary-Op |  Type  |    Time    |   GB/s   | % of Peak |     Result     |" << std::endl;
+    std::cout << "+-----------------+-------------+-----------+--------+------------+----------+-----------+----------------+" << std::endl;
 
     std::cout << "| std::accumulate |   Serial    |     +     | double | ";
-    auto [acc_time, acc_result] = measure<>::execution([](const auto& v){ return std::accumulate(v.begin(), v.end(), 0.0); }, v);
-    std::cout << std::setw(7) << acc_time << " us |  " << acc_result << "  |" << std::endl;
-    std::cout << "+-----------------+-------------+-----------+--------+------------+----------------+" << std::endl;
+    auto [acc_time, acc_result] = bench.execution("std::accumulate", "Serial", [](const auto& v){ return std::accumulate(v.begin(), v.end(), 0.0); }, v);
+    std::cout << std::setw(7) << acc_time << " us |" << bench.roofline_cells(bytes, acc_time) << "  " << acc_result << "  |" << std::endl;
+    std::cout << "+-----------------+-------------+-----------+--------+------------+----------+-----------+----------------+" << std::endl;
 
     std::cout << "|   std::reduce   | Sequencial  |     +     | double | ";
-    auto [seq_time, seq_result] = measure<>::execution([](const auto& v){ return std::reduce(std::execution::seq, v.begin(), v.end(), 0.0); }, v);
-    std::cout << std::setw(7) << seq_time << " us |  " << seq_result << "  |" << std::endl;
-    std::cout << "+-----------------+-------------+-----------+--------+------------+----------------+" << std::endl;
+    auto [seq_time, seq_result] = bench.execution("std::reduce", "Sequencial", [](const auto& v){ return std::reduce(std::execution::seq, v.begin(), v.end(), 0.0); }, v);
+    std::cout << std::setw(7) << seq_time << " us |" << bench.roofline_cells(bytes, seq_time) << "  " << seq_result << "  |" << std::endl;
+    std::cout << "+-----------------+-------------+-----------+--------+------------+----------+-----------+----------------+" << std::endl;
 
     std::cout << "|   std::reduce   |  Parallel   |     +     | double | ";
-    auto [par_time, par_result] = measure<>::execution([](const auto& v){ return std::reduce(std::execution::par, v.begin(), v.end(), 0.0); }, v);
-    std::cout << std::setw(7) << par_time << " us |  " << par_result << "  |" << std::endl;
-    std::cout << "+-----------------+-------------+-----------+--------+------------+----------------+" << std::endl;
+    auto [par_time, par_result] = bench.execution("std::reduce", "Parallel", [](const auto& v){ return std::reduce(std::execution::par, v.begin(), v.end(), 0.0); }, v);
+    std::cout << std::setw(7) << par_time << " us |" << bench.roofline_cells(bytes, par_time) << "  " << par_result << "  |" << std::endl;
+    std::cout << "+-----------------+-------------+-----------+--------+------------+----------+-----------+----------------+" << std::endl;
 
     std::cout << "|   std::reduce   | Unsequenced |     +     | double | ";
-    auto [unseq_time, unseq_result] = measure<>::execution([](const auto& v){ return std::reduce(std::execution::unseq, v.begin(), v.end(), 0.0); }, v);
-    std::cout << std::setw(7) << unseq_time << " us |  " << unseq_result << "  |" << std::endl;
-    std::cout << "+-----------------+-------------+-----------+--------+------------+----------------+" << std::endl;
+    auto [unseq_time, unseq_result] = bench.execution("std::reduce", "Unsequenced", [](const auto& v){ return std::reduce(std::execution::unseq, v.begin(), v.end(), 0.0); }, v);
+    std::cout << std::setw(7) << unseq_time << " us |" << bench.roofline_cells(bytes, unseq_time) << "  " << unseq_result << "  |" << std::endl;
+    std::cout << "+-----------------+-------------+-----------+--------+------------+----------+-----------+----------------+" << std::endl;
 
     std::cout << "|   std::reduce   |  Par-Unseq  |     +     | double | ";
-    auto [par_unseq_time, par_unseq_result] = measure<>::execution([](const auto& v){ return std::reduce(std::execution::par_unseq, v.begin(), v.end(), 0.0); }, v);
-    std::cout << std::setw(7) << par_unseq_time << " us |  " << par_unseq_result << "  |" << std::endl;
-    std::cout << "+-----------------+-------------+-----------+--------+------------+----------------+" << std::endl;
-    
+    auto [par_unseq_time, par_unseq_result] = bench.execution("std::reduce", "Par-Unseq", [](const auto& v){ return std::reduce(std::execution::par_unseq, v.begin(), v.end(), 0.0); }, v);
+    std::cout << std::setw(7) << par_unseq_time << " us |" << bench.roofline_cells(bytes, par_unseq_time) << "  " << par_unseq_result << "  |" << std::endl;
+    std::cout << "+-----------------+-------------+-----------+--------+------------+----------+-----------+----------------+" << std::endl;
+
+    bench.save();
+    std::cout << "Results: " << bench.path() << std::endl;
+
     return 0;
 }
\ No newline at end of file
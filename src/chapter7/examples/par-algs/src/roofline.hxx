@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <execution>
+#include <functional>
+#include <initializer_list>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+#include <tbb/task_arena.h>
+
+#include "scaling.hxx"
+
+/// Machine baselines for reading benchmark times: sustainable memory
+/// bandwidth (the four STREAM kernels) and peak floating-point throughput,
+/// combined into a roofline.
+///
+/// A kernel moving `bytes` and doing `flops` has arithmetic intensity
+/// `flops / bytes`; no implementation can beat
+/// `min(peak_flops, intensity * peak_bandwidth)`. Dividing what a kernel
+/// achieves by that bound says how much headroom is left, and which of the
+/// two limits is the one to fight.
+///
+/// Both probes run through `scale`, so they are measured at the same thread
+/// counts and with the same pinning as the scaling runs.
+
+struct stream_kernel
+{
+    std::string_view name;
+    std::size_t bytes_per_element;
+    std::size_t flops_per_element;
+};
+
+/// STREAM's kernels over `a`, `b`, `c` with scalar `q`. Byte counts follow
+/// STREAM: reads plus writes, ignoring write-allocate traffic.
+inline constexpr auto stream_kernels = std::array<stream_kernel, 4>{ {
+    { "copy",  16, 0 },     ///< c = a
+    { "scale", 16, 1 },     ///< b = q * c
+    { "add",   24, 1 },     ///< c = a + b
+    { "triad", 24, 2 },     ///< a = b + q * c
+} };
+
+namespace roofline_detail
+{
+    /// Independent multiply-add chains per worker; enough to cover the add
+    /// latency on every port with the vector width the flags allow.
+    inline constexpr auto chains = std::size_t{ 32 };
+
+    /// Two flops per chain per iteration. Whether the pair becomes one FMA
+    /// is up to the compiler flags, the same as for the kernels measured
+    /// against it.
+    inline auto
+    multiply_add(std::size_t iterations, double seed) noexcept -> double
+    {
+        auto acc = std::array<double, chains>{};
+        for (auto j = std::size_t{ 0 }; j < chains; ++j)
+            acc[j] = seed + static_cast<double>(j);
+
+        for (auto i = std::size_t{ 0 }; i < iterations; ++i)
+            for (auto& a : acc)
+                a = a * 0.999999 + 1e-6;
+
+        return std::accumulate(acc.begin(), acc.end(), 0.0);
+    }
+}
+
+struct bandwidth_point
+{
+    std::string_view kernel;
+    std::size_t threads;
+    double gb_per_s;
+};
+
+/// Runs every STREAM kernel over arrays of `elements` doubles for each
+/// thread count up to `max_threads`.
+inline auto
+probe_bandwidth(std::size_t elements, std::size_t max_threads, std::size_t repeats = 5) -> std::vector<bandwidth_point>
+{
+    auto a = std::vector<double>{};
+    auto b = std::vector<double>{};
+    auto c = std::vector<double>{};
+    auto q = 3.0;
+
+    auto prepare = [&](std::size_t n)
+    {
+        /// Resized inside the arena and first touched in parallel, so pages
+        /// land near the threads that use them.
+        for (auto* v : { &a, &b, &c })
+        {
+            v->clear();
+            v->shrink_to_fit();
+            v->resize(n);
+        }
+        std::fill(std::execution::par_unseq, a.begin(), a.end(), 1.0);
+        std::fill(std::execution::par_unseq, b.begin(), b.end(), 2.0);
+        std::fill(std::execution::par_unseq, c.begin(), c.end(), 0.0);
+    };
+
+    auto runs = std::array{
+        +[](std::vector<double>& a, std::vector<double>&, std::vector<double>& c, double)
+        { std::copy(std::execution::par_unseq, a.begin(), a.end(), c.begin()); },
+        +[](std::vector<double>&, std::vector<double>& b, std::vector<double>& c, double q)
+        { std::transform(std::execution::par_unseq, c.begin(), c.end(), b.begin(), [q](double x) { return q * x; }); },
+        +[](std::vector<double>& a, std::vector<double>& b, std::vector<double>& c, double)
+        { std::transform(std::execution::par_unseq, a.begin(), a.end(), b.begin(), c.begin(), std::plus<>{}); },
+        +[](std::vector<double>& a, std::vector<double>& b, std::vector<double>& c, double q)
+        { std::transform(std::execution::par_unseq, b.begin(), b.end(), c.begin(), a.begin(), [q](double x, double y) { return x + q * y; }); },
+    };
+
+    auto cfg = scaling_config{ scaling_mode::strong, max_threads, elements, repeats };
+    auto out = std::vector<bandwidth_point>{};
+    for (auto k = std::size_t{ 0 }; k < stream_kernels.size(); ++k)
+    {
+        auto points = scale(cfg, prepare, [&] { runs[k](a, b, c, q); });
+        for (const auto& p : points)
+        {
+            auto bytes = static_cast<double>(stream_kernels[k].bytes_per_element * p.size);
+            out.push_back(bandwidth_point{ stream_kernels[k].name, p.threads, bytes / (p.time_us * 1e3) });
+        }
+    }
+    return out;
+}
+
+struct compute_point
+{
+    std::size_t threads;
+    double gflops;
+};
+
+/// Peak multiply-add throughput for each thread count up to `max_threads`.
+inline auto
+probe_compute(std::size_t max_threads, std::size_t iterations = std::size_t{ 1 } << 24, std::size_t repeats = 3) -> std::vector<compute_point>
+{
+    auto sink = std::vector<double>{};
+    auto ids = std::vector<std::size_t>{};
+
+    /// Worker ids go in a vector: the parallel algorithms run a
+    /// `std::views::iota` range on the calling thread.
+    auto prepare = [&](std::size_t)
+    {
+        auto workers = static_cast<std::size_t>(tbb::this_task_arena::max_concurrency());
+        sink.assign(workers, 0.0);
+        ids.resize(workers);
+        std::iota(ids.begin(), ids.end(), std::size_t{ 0 });
+    };
+
+    auto run = [&]
+    {
+        std::for_each(std::execution::par, ids.begin(), ids.end(), [&](std::size_t w)
+        { sink[w] += roofline_detail::multiply_add(iterations, static_cast<double>(w)); });
+    };
+
+    auto cfg = scaling_config{ scaling_mode::strong, max_threads, 1, repeats };
+    auto out = std::vector<compute_point>{};
+    for (const auto& p : scale(cfg, prepare, run))
+    {
+        auto flops = 2.0 * static_cast<double>(roofline_detail::chains * iterations * p.threads);
+        out.push_back(compute_point{ p.threads, flops / (p.time_us * 1e3) });
+    }
+    return out;
+}
+
+/// Where a kernel sits under the roofline.
+struct roofline_position
+{
+    double gb_per_s;
+    double gflops;
+    double intensity;           ///< flops per byte
+    double attainable_gflops;   ///< the roof at this intensity
+    double percent_of_bandwidth;
+    double percent_of_roof;
+    bool memory_bound;
+};
+
+struct roofline
+{
+    double peak_gb_per_s;
+    double peak_gflops;
+
+    /// Roofs from probe results at `threads`, taking the best STREAM kernel
+    /// as the bandwidth roof.
+    static auto
+    from(const std::vector<bandwidth_point>& bw, const std::vector<compute_point>& fl, std::size_t threads) -> roofline
+    {
+        auto r = roofline{ 0.0, 0.0 };
+        for (const auto& p : bw)
+            if (p.threads == threads)
+                r.peak_gb_per_s = std::max(r.peak_gb_per_s, p.gb_per_s);
+        for (const auto& p : fl)
+            if (p.threads == threads)
+                r.peak_gflops = std::max(r.peak_gflops, p.gflops);
+        return r;
+    }
+
+    /// Measures both roofs at `max_threads`.
+    static auto
+    measure(std::size_t elements, std::size_t max_threads) -> roofline
+    { return from(probe_bandwidth(elements, max_threads), probe_compute(max_threads), max_threads); }
+
+    auto
+    position(double bytes, double flops, double time_us) const noexcept -> roofline_position
+    {
+        auto gbs = bytes / (time_us * 1e3);
+        auto gfl = flops / (time_us * 1e3);
+        auto ai = bytes > 0.0 ? flops / bytes : 0.0;
+        auto roof = std::min(peak_gflops, ai * peak_gb_per_s);
+        auto memory_bound = ai * peak_gb_per_s < peak_gflops;
+
+        /// A kernel with no flops is judged on bandwidth alone.
+        auto of_roof = roof > 0.0 ? 100.0 * gfl / roof : 100.0 * gbs / peak_gb_per_s;
+        return roofline_position{ gbs, gfl, ai, roof, 100.0 * gbs / peak_gb_per_s, of_roof, memory_bound || flops == 0.0 };
+    }
+};
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <execution>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_results.hxx"
+#include "data_gen.hxx"
+#include "roofline.hxx"
+
+/// Usage: roofline [max threads] [elements] [results file]
+///
+/// Measures the machine's bandwidth and compute roofs, then places each
+/// par-algs kernel under them. Every repetition of every kernel is saved to
+/// the results file (default `roofline-<unix time>.tsv`) for `compare`.
+
+static constexpr auto repeats = std::size_t{ 10 };
+
+/// Times `repeats` runs of `f`, in microseconds.
+template <typename F>
+auto samples_of(std::size_t repeats, F f) -> std::vector<double>
+{
+    auto samples = std::vector<double>{};
+    for (auto r = std::size_t{ 0 }; r < repeats; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    return samples;
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto cpus = allowed_cpus();
+    auto max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : cpus.size();
+    auto elements = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::size_t{ 1 } << 25;
+
+    auto store = result_store::for_this_run();
+    auto results = argc > 3 ? std::string{ argv[3] } : "roofline-" + store.metadata().at("timestamp") + ".tsv";
+    store.set_metadata("benchmark", "roofline");
+    store.set_metadata("elements", std::to_string(elements));
+    store.set_metadata("max_threads", std::to_string(max_threads));
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    /// Bandwidth roof.
+    auto bw = probe_bandwidth(elements, max_threads);
+    auto bw_line = std::string{ "+--------+---------+------------+" };
+    std::cout << "STREAM, " << elements << " doubles per array" << std::endl;
+    std::cout << bw_line << std::endl;
+    std::cout << "| Kernel | Threads |    GB/s    |" << std::endl;
+    std::cout << bw_line << std::endl;
+    for (const auto& p : bw)
+        std::cout << "| " << std::left << std::setw(6) << p.kernel << std::right
+                  << " | " << std::setw(7) << p.threads
+                  << " | " << std::setw(10) << p.gb_per_s << " |" << std::endl;
+    std::cout << bw_line << std::endl << std::endl;
+
+    /// Compute roof.
+    auto fl = probe_compute(max_threads);
+    auto fl_line = std::string{ "+---------+------------+" };
+    std::cout << "Multiply-add peak" << std::endl;
+    std::cout << fl_line << std::endl;
+    std::cout << "| Threads |  GFLOP/s   |" << std::endl;
+    std::cout << fl_line << std::endl;
+    for (const auto& p : fl)
+        std::cout << "| " << std::setw(7) << p.threads << " | " << std::setw(10) << p.gflops << " |" << std::endl;
+    std::cout << fl_line << std::endl << std::endl;
+
+    auto roof = roofline::from(bw, fl, max_threads);
+    store.set_metadata("peak_gb_per_s", std::to_string(roof.peak_gb_per_s));
+    store.set_metadata("peak_gflops", std::to_string(roof.peak_gflops));
+    std::cout << "Roofline: " << roof.peak_gb_per_s << " GB/s, " << roof.peak_gflops << " GFLOP/s, ridge at "
+              << roof.peak_gflops / roof.peak_gb_per_s << " flop/byte" << std::endl << std::endl;
+
+    /// The par-algs kernels on the same machine.
+    auto v = std::vector<double>(elements);
+    auto w = std::vector<double>(elements);
+    auto r = std::vector<double>(elements);
+    fill_uniform(std::span{ v }, 0.0, 0.2, 42);
+    fill_normal(std::span{ w }, 0.524, 0.1, 43);
+    auto times2 = [](double x) { return x * 2; };
+    auto sink = 0.0;
+
+    auto line = std::string{ "+--------------------------+-------------+------------+----------+---------+-----------+------------+-----------+--------+" };
+    std::cout << line << std::endl;
+    std::cout << "|        Algorithm         | Exec Policy |    Time    |   GB/s   | % of BW |  GFLOP/s  | flop/byte  | % of Roof | Bound  |" << std::endl;
+    std::cout << line << std::endl;
+
+    auto n = static_cast<double>(elements);
+    auto row = [&](std::string_view name, std::string_view policy, double bytes, double flops, auto f)
+    {
+        auto samples = samples_of(repeats, f);
+        store.add(std::string{ name }, std::string{ policy }, "us", samples);
+
+        auto us = std::ranges::min(samples);
+        auto p = roof.position(bytes, flops, us);
+        std::cout << "| " << std::left << std::setw(24) << name
+                  << " | " << std::setw(11) << policy << std::right
+                  << " | " << std::setw(7) << static_cast<std::uint64_t>(us) << " us"
+                  << " | " << std::setw(8) << p.gb_per_s
+                  << " | " << std::setw(6) << p.percent_of_bandwidth << "%"
+                  << " | " << std::setw(9) << p.gflops
+                  << " | " << std::setw(10) << p.intensity
+                  << " | " << std::setw(8) << p.percent_of_roof << "%"
+                  << " | " << (p.memory_bound ? "memory" : "compute") << std::setw(p.memory_bound ? 2 : 1) << "|" << std::endl;
+    };
+
+    auto policies = [&](std::string_view name, double bytes, double flops, auto f)
+    {
+        row(name, "Sequencial", bytes, flops, [&] { f(std::execution::seq); });
+        row(name, "Unsequenced", bytes, flops, [&] { f(std::execution::unseq); });
+        row(name, "Parallel", bytes, flops, [&] { f(std::execution::par); });
+        row(name, "Par-Unseq", bytes, flops, [&] { f(std::execution::par_unseq); });
+        std::cout << line << std::endl;
+    };
+
+    policies("std::reduce", 8 * n, n, [&](auto policy)
+    { sink += std::reduce(policy, v.begin(), v.end(), 0.0); });
+    policies("std::transform_reduce", 16 * n, 2 * n, [&](auto policy)
+    { sink += std::transform_reduce(policy, v.begin(), v.end(), w.begin(), 0.0); });
+    policies("std::inclusive_scan", 16 * n, n, [&](auto policy)
+    { std::inclusive_scan(policy, v.begin(), v.end(), r.begin()); });
+    policies("std::exclusive_scan", 16 * n, n, [&](auto policy)
+    { std::exclusive_scan(policy, v.begin(), v.end(), r.begin(), 0.0); });
+    policies("transform_inclusive_scan", 16 * n, 2 * n, [&](auto policy)
+    { std::transform_inclusive_scan(policy, v.begin(), v.end(), r.begin(), std::plus<>{}, times2); });
+    policies("transform_exclusive_scan", 16 * n, 2 * n, [&](auto policy)
+    { std::transform_exclusive_scan(policy, v.begin(), v.end(), r.begin(), 0.0, std::plus<>{}, times2); });
+
+    store.save(results);
+    std::cout << "Checksum: " << sink + r.back() << std::endl;
+    std::cout << "Results: " << results << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <sched.h>
+
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+
+/// Strong- and weak-scaling runs of parallel-algorithm kernels.
+///
+/// The parallel algorithms of libstdc++ run on TBB, so the worker count is
+/// controlled the way TBB controls it: `tbb::global_control` caps the
+/// parallelism of the whole process and a `tbb::task_arena` of the same
+/// size runs the kernel. Every thread that joins the arena is pinned to one
+/// CPU of a fixed list, as `taskset` would, so a run with `t` threads uses
+/// exactly `t` cores and results do not depend on where the OS migrates
+/// threads.
+///
+/// Strong scaling keeps the problem size fixed and reports speedup
+/// `T(1) / T(t)` and efficiency `speedup / t`. Weak scaling grows the size
+/// with the thread count, `size_per_thread * t`, and reports the scaled
+/// speedup `t * T(1) / T(t)`, so ideal efficiency is 1 in both modes.
+
+/// CPUs this process may run on, in ascending order.
+inline auto
+allowed_cpus() -> std::vector<int>
+{
+    auto set = cpu_set_t{};
+    CPU_ZERO(&set);
+    if (::sched_getaffinity(0, sizeof(set), &set) != 0)
+        throw std::system_error(errno, std::generic_category(), "sched_getaffinity");
+
+    auto cpus = std::vector<int>{};
+    for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &set))
+            cpus.push_back(cpu);
+    return cpus;
+}
+
+/// Pins each thread entering `arena` to the next CPU of `cpus`, round robin,
+/// and restores its previous mask when it leaves.
+class pinning_observer : public tbb::task_scheduler_observer
+{
+public:
+
+    pinning_observer(tbb::task_arena& arena, std::vector<int> cpus)
+        : tbb::task_scheduler_observer{ arena }
+        , m_cpus{ std::move(cpus) }
+    { observe(true); }
+
+    ~pinning_observer() override
+    { observe(false); }
+
+    auto
+    on_scheduler_entry(bool) -> void override
+    {
+        auto slot = tbb::this_task_arena::current_thread_index();
+        if (slot < 0 || m_cpus.empty())
+            return;
+
+        ::sched_getaffinity(0, sizeof(s_saved), &s_saved);
+
+        auto set = cpu_set_t{};
+        CPU_ZERO(&set);
+        CPU_SET(m_cpus[static_cast<std::size_t>(slot) % m_cpus.size()], &set);
+        ::sched_setaffinity(0, sizeof(set), &set);
+    }
+
+    auto
+    on_scheduler_exit(bool) -> void override
+    { ::sched_setaffinity(0, sizeof(s_saved), &s_saved); }
+
+private:
+
+    std::vector<int> m_cpus;
+    static inline thread_local cpu_set_t s_saved;
+};
+
+enum class scaling_mode { strong, weak };
+
+inline auto
+to_string(scaling_mode mode) noexcept -> std::string_view
+{ return mode == scaling_mode::strong ? "strong" : "weak"; }
+
+struct scaling_config
+{
+    scaling_mode mode { scaling_mode::strong };
+
+    /// Largest thread count tried; runs go 1, 2, 4, ... up to it (and it).
+    std::size_t max_threads { 1 };
+
+    /// Strong: the problem size. Weak: the size per thread.
+    std::size_t size { 1 };
+
+    /// Each point reports the fastest of this many runs.
+    std::size_t repeats { 3 };
+
+    /// CPUs to pin to; the first `t` are used for a run with `t` threads.
+    std::vector<int> cpus { allowed_cpus() };
+};
+
+struct scaling_point
+{
+    std::size_t threads;
+    std::size_t size;
+    double time_us;
+    double speedup;
+    double efficiency;
+
+    /// Every timed run, in microseconds; `time_us` is the fastest.
+    std::vector<double> samples;
+};
+
+/// Thread counts of a sweep: powers of two up to `max_threads`, plus
+/// `max_threads` itself.
+inline auto
+thread_counts(std::size_t max_threads) -> std::vector<std::size_t>
+{
+    auto counts = std::vector<std::size_t>{};
+    for (auto t = std::size_t{ 1 }; t < max_threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(std::max(max_threads, std::size_t{ 1 }));
+    return counts;
+}
+
+/// Runs one kernel over the sweep. `prepare(size)` builds the input for a
+/// run and is not timed; `run()` is the timed kernel. Both execute inside
+/// the constrained arena, so the input is first touched by the threads that
+/// will use it.
+template <typename Prepare, typename Run>
+auto
+scale(const scaling_config& cfg, Prepare prepare, Run run) -> std::vector<scaling_point>
+{
+    if (cfg.max_threads == 0 || cfg.max_threads > cfg.cpus.size())
+        throw std::invalid_argument("Thread Count Exceeds Allowed CPUs");
+
+    auto points = std::vector<scaling_point>{};
+    for (auto t : thread_counts(cfg.max_threads))
+    {
+        auto size = cfg.mode == scaling_mode::strong ? cfg.size : cfg.size * t;
+
+        auto limit = tbb::global_control{ tbb::global_control::max_allowed_parallelism, t };
+        auto arena = tbb::task_arena{ static_cast<int>(t) };
+        auto pin = pinning_observer{ arena, std::vector<int>(cfg.cpus.begin(), cfg.cpus.begin() + static_cast<std::ptrdiff_t>(t)) };
+
+        auto samples = std::vector<double>{};
+        arena.execute([&]
+        {
+            prepare(size);
+            for (auto r = std::size_t{ 0 }; r < std::max(cfg.repeats, std::size_t{ 1 }); ++r)
+            {
+                auto start = std::chrono::steady_clock::now();
+                run();
+                samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+        });
+
+        auto best = std::ranges::min(samples);
+        points.push_back(scaling_point{ t, size, best, 0.0, 0.0, std::move(samples) });
+    }
+
+    auto base = points.front().time_us;
+    for (auto& p : points)
+    {
+        auto t = static_cast<double>(p.threads);
+        p.speedup = cfg.mode == scaling_mode::strong ? base / p.time_us : t * base / p.time_us;
+        p.efficiency = p.speedup / t;
+    }
+
+    return points;
+}
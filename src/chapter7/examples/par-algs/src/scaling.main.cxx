@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <execution>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_results.hxx"
+#include "data_gen.hxx"
+#include "radix_sort.hxx"
+#include "scaling.hxx"
+
+/// Usage: scaling [strong | weak | both] [max threads] [elements] [results file]
+///
+/// `elements` is the strong-scaling size. Weak scaling uses
+/// `elements / max threads` per thread, so its largest run is the same size.
+/// Every repetition of every point is saved to the results file (default
+/// `scaling-<unix time>.tsv`), keyed by kernel and "policy, mode, threads".
+
+/// Timed runs per point; `compare` needs several to test for a change.
+static constexpr auto repeats = std::size_t{ 10 };
+
+static const auto line = std::string{ "+-----------------------+-------------+--------+---------+-------------+------------+---------+------------+" };
+
+auto print(result_store& store, std::string_view kernel, std::string_view policy, scaling_mode mode, const std::vector<scaling_point>& points) -> void
+{
+    for (const auto& p : points)
+    {
+        store.add(std::string{ kernel }, std::string{ policy } + ", " + std::string{ to_string(mode) } + ", " + std::to_string(p.threads) + " threads", "us", p.samples);
+        std::cout << "| " << std::left << std::setw(21) << kernel
+                  << " | " << std::setw(11) << policy
+                  << " | " << std::setw(6) << to_string(mode) << std::right
+                  << " | " << std::setw(7) << p.threads
+                  << " | " << std::setw(11) << p.size
+                  << " | " << std::setw(7) << static_cast<std::uint64_t>(p.time_us) << " us"
+                  << " | " << std::setw(6) << p.speedup << "x"
+                  << " | " << std::setw(9) << p.efficiency * 100.0 << "% |" << std::endl;
+    }
+    std::cout << line << std::endl;
+}
+
+/// Runs every kernel under one scaling mode.
+auto sweep(result_store& store, const scaling_config& cfg) -> void
+{
+    auto v = std::vector<double>{};
+    auto w = std::vector<double>{};
+    auto k = std::vector<std::uint32_t>{};
+    auto sink = 0.0;
+
+    auto doubles = [&](std::size_t n)
+    {
+        v.resize(n);
+        w.resize(n);
+        fill_uniform(std::span{ v }, 0.0, 0.2, 42);
+        fill_normal(std::span{ w }, 0.524, 0.1, 43);
+    };
+
+    auto run = [&](std::string_view kernel, std::string_view policy, auto prepare, auto kernel_fn)
+    { print(store, kernel, policy, cfg.mode, scale(cfg, prepare, kernel_fn)); };
+
+    run("std::reduce", "Parallel", doubles, [&] { sink += std::reduce(std::execution::par, v.begin(), v.end(), 0.0); });
+    run("std::reduce", "Par-Unseq", doubles, [&] { sink += std::reduce(std::execution::par_unseq, v.begin(), v.end(), 0.0); });
+    run("std::transform_reduce", "Par-Unseq", doubles, [&] { sink += std::transform_reduce(std::execution::par_unseq, v.begin(), v.end(), w.begin(), 0.0); });
+    run("std::inclusive_scan", "Parallel", doubles, [&] { std::inclusive_scan(std::execution::par, v.begin(), v.end(), w.begin()); });
+    run("std::inclusive_scan", "Par-Unseq", doubles, [&] { std::inclusive_scan(std::execution::par_unseq, v.begin(), v.end(), w.begin()); });
+
+    /// Sorting destroys its input, so every timed repeat sorts a fresh copy
+    /// of `v` in `w`; the copy is part of the time.
+    run("std::sort", "Par-Unseq", doubles, [&]
+    {
+        std::copy(std::execution::par_unseq, v.begin(), v.end(), w.begin());
+        std::sort(std::execution::par_unseq, w.begin(), w.end());
+    });
+
+    auto keys = [&](std::size_t n)
+    {
+        k.resize(n);
+        fill_uniform(std::span{ k }, 0u, ~0u, 42);
+    };
+
+    run("radix_sort", "Parallel", keys, [&]
+    {
+        auto copy = k;
+        radix_sort(copy);
+    });
+
+    /// Keeps the reductions observable.
+    std::cout << "Checksum (" << to_string(cfg.mode) << "): " << sink << std::endl;
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto mode = argc > 1 ? std::string_view{ argv[1] } : std::string_view{ "both" };
+    auto cpus = allowed_cpus();
+    auto max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : cpus.size();
+    auto elements = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : std::size_t{ 1 } << 25;
+
+    if (mode != "strong" && mode != "weak" && mode != "both")
+    {
+        std::cerr << "Usage: " << argv[0] << " [strong | weak | both] [max threads] [elements] [results file]" << std::endl;
+        return 1;
+    }
+
+    auto store = result_store::for_this_run();
+    store.set_metadata("benchmark", "scaling");
+    store.set_metadata("max_threads", std::to_string(max_threads));
+    store.set_metadata("elements", std::to_string(elements));
+    auto path = argc > 4 ? std::string{ argv[4] } : "scaling-" + store.metadata().at("timestamp") + ".tsv";
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Allowed CPUs: " << cpus.size() << ", max threads: " << max_threads << std::endl;
+    std::cout << line << std::endl;
+    std::cout << "|        Kernel         | Exec Policy |  Mode  | Threads |    Size     |    Time    | Speedup | Efficiency |" << std::endl;
+    std::cout << line << std::endl;
+
+    if (mode != "weak")
+        sweep(store, scaling_config{ scaling_mode::strong, max_threads, elements, repeats, cpus });
+    if (mode != "strong")
+        sweep(store, scaling_config{ scaling_mode::weak, max_threads, std::max<std::size_t>(elements / max_threads, 1), repeats, cpus });
+
+    store.save(path);
+    std::cout << "Results: " << path << std::endl;
+
+    return 0;
+}
@@ -1,25 +1,14 @@
 #include <algorithm>
-#include <chrono>
 #include <execution>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
+#include <span>
 #include <utility>
 #include <vector>
 
-template <typename time_t = std::chrono::microseconds>
-struct measure
-{
-    template <typename F, typename... Args>
-    static auto execution(F func, Args&&... args) 
-        -> typename time_t::rep
-    {
-        auto start = std::chrono::system_clock::now();
-        std::invoke(func, std::forward<Args>(args)...);
-        auto duration = std::chrono::duration_cast<time_t>(std::chrono::system_clock::now() - start);
-        return duration.count();
-    }
-};
+#include "data_gen.hxx"
+#include "par_bench.hxx"
 
 template<typename T>
 auto operator<< 
@@ -36,37 +25,45 @@ auto operator<<
     return os;
 }
 
-auto main() -> int
+auto main(int argc, char* argv[]) -> int
 {
-    auto v = std::vector<double>(100'000'007, 0.1);
+    auto bench = par_bench{ "transform_exclusive_scan", argc, argv };
+
+    auto v = std::vector<double>(100'000'007);
+    fill_uniform(std::span{ v }, 0.0, 0.2, 42);
     auto r = std::vector<double>(100'000'007, 0.0);
     auto times2 = [](const auto& x){ return x * 2; };
+    /// Bytes each run moves: input read, output written.
+    auto bytes = 16.0 * static_cast<double>(v.size());
     std::cout.imbue(std::locale("en_US.UTF-8"));
     std::cout << std::fixed << std::setprecision(1);
     
-    std::cout << "+-------------------------------+-------------+-------------+--------+------------+-----------------------------------------------+" << std::endl;
-    std::cout << "|           Algorithm           | Exec Policy | Operations  |  Type  |    Time    |                    Result                     |" << std::endl;
-    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+-----------------------------------------------+" << std::endl;
+    std::cout << "+-------------------------------+-------------+-------------+--------+------------+----------+-----------+-----------------------------------------------+" << std::endl;
+    std::cout << "|           Algorithm           | Exec Policy | Operations  |  Type  |    Time    |   GB/s   | % of Peak |                    Result                     |" << std::endl;
+    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+----------+-----------+-----------------------------------------------+" << std::endl;
 
     std::cout << "| std::transform_exclusive_scan | Sequencial  | (*2) -> (+) | double | ";
-    auto seq_time = measure<>::execution([&](const auto& v, auto& r){  std::transform_exclusive_scan(std::execution::seq, v.begin(), v.end(), r.begin(), 0.0, std::plus<>{}, times2); }, v, r);
-    std::cout << std::setw(7) << seq_time << " us | " << r << " |" << std::endl;
-    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+-----------------------------------------------+" << std::endl;
+    auto seq_time = bench.execution("std::transform_exclusive_scan", "Sequencial", [&](const auto& v, auto& r){  std::transform_exclusive_scan(std::execution::seq, v.begin(), v.end(), r.begin(), 0.0, std::plus<>{}, times2); }, v, r);
+    std::cout << std::setw(7) << seq_time << " us |" << bench.roofline_cells(bytes, seq_time) << " " << r << " |" << std::endl;
+    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+----------+-----------+-----------------------------------------------+" << std::endl;
 
     std::cout << "| std::transform_exclusive_scan |  Parallel   | (*2) -> (+) | double | ";
-    auto par_time = measure<>::execution([&](const auto& v, auto& r){  std::transform_exclusive_scan(std::execution::par, v.begin(), v.end(), r.begin(), 0.0, std::plus<>{}, times2); }, v, r);
-    std::cout << std::setw(7) << par_time << " us | " << r << " |" << std::endl;
-    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+-----------------------------------------------+" << std::endl;
+    auto par_time = bench.execution("std::transform_exclusive_scan", "Parallel", [&](const auto& v, auto& r){  std::transform_exclusive_scan(std::execution::par, v.begin(), v.end(), r.begin(), 0.0, std::plus<>{}, times2); }, v, r);
+    std::cout << std::setw(7) << par_time << " us |" << bench.roofline_cells(bytes, par_time) << " " << r << " |" << std::endl;
+    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+----------+-----------+-----------------------------------------------+" << std::endl;
 
     std::cout << "| std::transform_exclusive_scan | Unsequenced | (*2) -> (+) | double | ";
-    auto unseq_time = measure<>::execution([&](const auto& v, auto& r){  std::transform_exclusive_scan(std::execution::unseq, v.begin(), v.end(), r.begin(), 0.0, std::plus<>{}, times2); }, v, r);
-    std::cout << std::setw(7) << unseq_time << " us | " << r << " |" << std::endl;
-    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+-----------------------------------------------+" << std::endl;
+    auto unseq_time = bench.execution("std::transform_exclusive_scan", "Unsequenced", [&](const auto& v, auto& r){  std::transform_exclusive_scan(std::execution::unseq, v.begin(), v.end(), r.begin(), 0.0, std::plus<>{}, times2); }, v, r);
+    std::cout << std::setw(7) << unseq_time << " us |" << bench.roofline_cells(bytes, unseq_time) << " " << r << " |" << std::endl;
+    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+----------+-----------+-----------------------------------------------+" << std::endl;
 
     std::cout << "| std::transform_exclusive_scan |  Par-Unseq  | (*2) -> (+) | double | ";
-    auto par_unseq_time = measure<>::execution([&](const auto& v, auto& r){  std::transform_exclusive_scan(std::execution::par_unseq, v.begin(), v.end(), r.begin(), 0.0, std::plus<>{}, times2); }, v, r);
-    std::cout << std::setw(7) << par_unseq_time << " us | " << r << " |" << std::endl;
-    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+-----------------------------------------------+" << std::endl;
-    
+    auto par_unseq_time = bench.execution("std::transform_exclusive_scan", "Par-Unseq", [&](const auto& v, auto& r){  std::transform_exclusive_scan(std::execution::par_unseq, v.begin(), v.end(), r.begin(), 0.0, std::plus<>{}, times2); }, v, r);
+    std::cout << std::setw(7) << par_unseq_time << " us |" << bench.roofline_cells(bytes, par_unseq_time) << " " << r << " |" << std::endl;
+    std::cout << "+--------------------+----------+-------------+-------------+--------+------------+----------+-----------+-----------------------------------------------+" << std::endl;
+
+    bench.save();
+    std::cout << "Results: " << bench.path() << std::endl;
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+/// What `async_logger::log()` does when the calling thread's buffer is full.
+enum class overflow
+{
+    block,  ///< Wait for the flusher to make room
+    drop    ///< Discard the message and count it
+};
+
+/// Arguments `async_logger::log()` can capture: anything trivially copyable.
+/// `const char*` arguments are captured by pointer so they must outlive the
+/// flush (string literals are fine).
+template<typename T>
+concept loggable = std::is_trivially_copyable_v<std::decay_t<T>>;
+
+/// Asynchronous logger with per-thread lock-free buffers.
+///
+/// `std::osyncstream(std::cout)` allocates a buffer per message and takes the
+/// stream's lock to emit it. Here `log()` only copies its (trivially
+/// copyable) arguments into a fixed size record in the calling thread's
+/// single-producer ring buffer; formatting happens later on a background
+/// flusher thread, which drains every ring into a batch and emits it with a
+/// single `write(2)` per batch.
+///
+/// Each thread's ring holds `capacity` records; when it is full the
+/// `overflow` policy either blocks the caller or drops the message.
+class async_logger
+{
+public:
+
+    /// Bytes available for a message's arguments; keeps records at two
+    /// cache lines.
+    static constexpr std::size_t payload_size = 112;
+
+    explicit
+    async_logger(int fd = STDOUT_FILENO,
+                 std::size_t capacity = 4096,
+                 overflow policy = overflow::block,
+                 std::chrono::microseconds flush_interval = std::chrono::microseconds{ 500 })
+        : m_fd{ fd }
+        , m_capacity{ std::bit_ceil(capacity) }
+        , m_policy{ policy }
+        , m_interval{ flush_interval }
+        , m_id{ _S_next_id() }
+        , m_flusher{ [this](std::stop_token tkn) { _M_flush_loop(tkn); } }
+    { }
+
+    async_logger(const async_logger&) = delete;
+    auto operator= (const async_logger&) -> async_logger& = delete;
+
+    /// Drains every buffer before returning.
+    ~async_logger() noexcept
+    {
+        m_flusher.request_stop();
+        m_flusher.join();
+    }
+
+    /// Queues a message made of `args` written back to back, the same as
+    /// `std::osyncstream(os) << args...`. Returns `false` if it was dropped.
+    template<loggable... Args>
+        requires (sizeof(std::tuple<std::decay_t<Args>...>) <= payload_size)
+    auto
+    log(Args&&... args) -> bool
+    {
+        using tuple = std::tuple<std::decay_t<Args>...>;
+
+        auto& ring = _M_local();
+        auto head = ring.head.load(std::memory_order_relaxed);
+
+        if (head - ring.cached_tail >= m_capacity)
+        {
+            ring.cached_tail = ring.tail.load(std::memory_order_acquire);
+            while (head - ring.cached_tail >= m_capacity)
+            {
+                if (m_policy == overflow::drop)
+                {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                std::this_thread::yield();
+                ring.cached_tail = ring.tail.load(std::memory_order_acquire);
+            }
+        }
+
+        auto& rec = ring.records[head & (m_capacity - 1)];
+        rec.format = &_S_format<tuple>;
+        ::new (static_cast<void*>(rec.payload.data())) tuple{ std::forward<Args>(args)... };
+        ring.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Blocks until every message queued before the call has been written.
+    auto
+    flush() noexcept -> void
+    {
+        auto target = std::vector<std::pair<const ring*, std::uint64_t>>{};
+        {
+            auto lk = std::lock_guard{ m_registry_mx };
+            for (const auto& r : m_rings)
+                target.emplace_back(r.get(), r->head.load(std::memory_order_acquire));
+        }
+
+        for (auto [r, head] : target)
+            while (r->tail.load(std::memory_order_acquire) < head)
+                std::this_thread::sleep_for(m_interval);
+    }
+
+    auto
+    dropped() const noexcept -> std::uint64_t
+    { return m_dropped.load(std::memory_order_relaxed); }
+
+    /// Number of `write(2)` calls made by the flusher.
+    auto
+    writes() const noexcept -> std::uint64_t
+    { return m_writes.load(std::memory_order_relaxed); }
+
+private:
+
+    static constexpr std::size_t cache_line = 64;
+    static constexpr std::size_t batch_size = 64 * 1024;
+
+    using formatter = void (*)(std::string&, const std::byte*);
+
+    struct record
+    {
+        formatter format;
+        alignas(std::max_align_t) std::array<std::byte, payload_size> payload;
+    };
+
+    /// Single producer (the owning thread), single consumer (the flusher).
+    struct ring
+    {
+        explicit
+        ring(std::size_t capacity)
+            : records{ std::make_unique<record[]>(capacity) }
+        { }
+
+        std::unique_ptr<record[]> records;
+        alignas(cache_line) std::atomic<std::uint64_t> head { 0 };
+        std::uint64_t cached_tail { 0 };
+        alignas(cache_line) std::atomic<std::uint64_t> tail { 0 };
+    };
+
+    template<typename T>
+    static auto
+    _S_append(std::string& out, const T& value) -> void
+    {
+        if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>)
+            out += value;
+        else if constexpr (std::is_same_v<T, char>)
+            out += value;
+        else if constexpr (std::is_same_v<T, bool>)
+            out += value ? "true" : "false";
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            auto buffer = std::array<char, 64>{};
+            auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+            out.append(buffer.data(), end);
+        }
+        else
+        {
+            auto ss = std::ostringstream{};
+            ss << value;
+            out += ss.str();
+        }
+    }
+
+    /// Instantiated per argument list; rebuilds the tuple and appends each
+    /// element to the batch.
+    template<typename Tuple>
+    static auto
+    _S_format(std::string& out, const std::byte* payload) -> void
+    {
+        const auto& args = *std::launder(reinterpret_cast<const Tuple*>(payload));
+        std::apply([&out](const auto&... a) { (_S_append(out, a), ...); }, args);
+    }
+
+    static auto
+    _S_next_id() noexcept -> std::uint64_t
+    {
+        static auto next = std::atomic<std::uint64_t>{ 0 };
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Finds (or registers) the calling thread's ring for this logger. Rings
+    /// are owned by the logger so messages survive their thread exiting.
+    auto
+    _M_local() -> ring&
+    {
+        thread_local auto cache = std::vector<std::pair<std::uint64_t, ring*>>{};
+
+        for (auto [id, r] : cache)
+            if (id == m_id)
+                return *r;
+
+        auto lk = std::lock_guard{ m_registry_mx };
+        auto& r = m_rings.emplace_back(std::make_unique<ring>(m_capacity));
+        cache.emplace_back(m_id, r.get());
+        return *r;
+    }
+
+    auto
+    _M_write(std::string& batch) -> void
+    {
+        auto data = batch.data();
+        auto left = batch.size();
+        while (left > 0)
+        {
+            auto n = ::write(m_fd, data, left);
+            if (n <= 0)
+                break;
+            data += n;
+            left -= static_cast<std::size_t>(n);
+        }
+
+        m_writes.fetch_add(1, std::memory_order_relaxed);
+        batch.clear();
+    }
+
+    /// Drains all rings once. Returns the number of records written.
+    auto
+    _M_drain(std::string& batch) -> std::size_t
+    {
+        auto rings = std::vector<ring*>{};
+        {
+            auto lk = std::lock_guard{ m_registry_mx };
+            rings.reserve(m_rings.size());
+            for (auto& r : m_rings)
+                rings.push_back(r.get());
+        }
+
+        auto drained = std::size_t{ 0 };
+        for (auto* r : rings)
+        {
+            auto tail = r->tail.load(std::memory_order_relaxed);
+            auto head = r->head.load(std::memory_order_acquire);
+            drained += head - tail;
+
+            for (; tail != head; ++tail)
+            {
+                auto& rec = r->records[tail & (m_capacity - 1)];
+                rec.format(batch, rec.payload.data());
+
+                if (batch.size() >= batch_size)
+                {
+                    r->tail.store(tail + 1, std::memory_order_release);
+                    _M_write(batch);
+                }
+            }
+
+            r->tail.store(tail, std::memory_order_release);
+        }
+
+        return drained;
+    }
+
+    auto
+    _M_flush_loop(std::stop_token tkn) -> void
+    {
+        auto batch = std::string{};
+        batch.reserve(batch_size + 1024);
+
+        while (!tkn.stop_requested())
+        {
+            auto drained = _M_drain(batch);
+            if (!batch.empty())
+                _M_write(batch);
+            if (drained == 0)
+                std::this_thread::sleep_for(m_interval);
+        }
+
+        _M_drain(batch);
+        if (!batch.empty())
+            _M_write(batch);
+    }
+
+    int m_fd;
+    std::size_t m_capacity;
+    overflow m_policy;
+    std::chrono::microseconds m_interval;
+    std::uint64_t m_id;
+
+    std::mutex m_registry_mx;
+    std::vector<std::unique_ptr<ring>> m_rings;
+
+    std::atomic<std::uint64_t> m_dropped { 0 };
+    std::atomic<std::uint64_t> m_writes { 0 };
+
+    std::jthread m_flusher;
+};
@@ -0,0 +1,343 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "timer_wheel.hxx"
+
+/// Counter whose waits can be cancelled through a `std::stop_token`.
+///
+/// `std::atomic::wait` only returns once the value changes, so a stop
+/// request can't wake it without disturbing the value. This keeps the value
+/// in the low 32 bits and a wake generation in the high 32 bits: a stop
+/// callback bumps the generation and notifies, which wakes every waiter so
+/// the cancelled one can leave while the others re-check and sleep again.
+class stop_aware_counter
+{
+public:
+
+    using value_type = std::uint32_t;
+
+    explicit constexpr
+    stop_aware_counter(value_type value = 0) noexcept
+        : m_word{ value }
+    { }
+
+    auto
+    load(std::memory_order order = std::memory_order_seq_cst) const noexcept -> value_type
+    { return static_cast<value_type>(m_word.load(order)); }
+
+    auto
+    fetch_add(value_type n, std::memory_order order = std::memory_order_seq_cst) noexcept -> value_type
+    {
+        auto word = m_word.load(std::memory_order_relaxed);
+        while (!m_word.compare_exchange_weak(word, (word & generation_mask) | static_cast<value_type>(word + n), order))
+            ;
+        m_word.notify_all();
+        return static_cast<value_type>(word);
+    }
+
+    auto
+    store(value_type value, std::memory_order order = std::memory_order_seq_cst) noexcept -> void
+    {
+        auto word = m_word.load(std::memory_order_relaxed);
+        while (!m_word.compare_exchange_weak(word, (word & generation_mask) | value, order))
+            ;
+        m_word.notify_all();
+    }
+
+    /// Blocks while the value equals `old`. Returns `false` if woken by a
+    /// stop request instead of a change.
+    auto
+    wait(value_type old, std::stop_token tkn) const noexcept -> bool
+    {
+        auto wake = std::stop_callback{ tkn, [this]() noexcept
+        {
+            m_word.fetch_add(generation_one, std::memory_order_release);
+            m_word.notify_all();
+        } };
+
+        auto word = m_word.load(std::memory_order_acquire);
+        while (static_cast<value_type>(word) == old)
+        {
+            if (tkn.stop_requested())
+                return false;
+            m_word.wait(word, std::memory_order_acquire);
+            word = m_word.load(std::memory_order_acquire);
+        }
+
+        return true;
+    }
+
+private:
+
+    static constexpr std::uint64_t generation_one  = std::uint64_t{ 1 } << 32;
+    static constexpr std::uint64_t generation_mask = ~std::uint64_t{ 0 } << 32;
+
+    mutable std::atomic<std::uint64_t> m_word;
+};
+
+class job_runner;
+class job_context;
+
+/// Shared state of a submitted job.
+struct job_state
+{
+    /// Forwards a parent's stop request to a child's stop source.
+    struct forward_stop
+    {
+        std::stop_source target;
+
+        auto
+        operator() () noexcept -> void
+        { target.request_stop(); }
+    };
+
+    std::function<void(job_context&)> body;
+    std::stop_source source;
+    std::optional<std::stop_callback<forward_stop>> parent_link;
+    std::atomic<bool> done { false };
+    std::atomic<bool> timed_out { false };
+};
+
+/// Handle to a submitted job.
+class job_handle
+{
+public:
+
+    job_handle() noexcept = default;
+
+    explicit
+    job_handle(std::shared_ptr<job_state> state) noexcept
+        : m_state{ std::move(state) }
+    { }
+
+    /// Requests cancellation of the job and, transitively, its children.
+    auto
+    cancel() const noexcept -> bool
+    { return m_state->source.request_stop(); }
+
+    auto
+    cancelled() const noexcept -> bool
+    { return m_state->source.stop_requested(); }
+
+    auto
+    timed_out() const noexcept -> bool
+    { return m_state->timed_out.load(std::memory_order_acquire); }
+
+    auto
+    done() const noexcept -> bool
+    { return m_state->done.load(std::memory_order_acquire); }
+
+    /// Blocks until the job has finished (run to completion or returned
+    /// early after cancellation).
+    auto
+    wait() const noexcept -> void
+    { m_state->done.wait(false, std::memory_order_acquire); }
+
+    auto
+    get_stop_token() const noexcept -> std::stop_token
+    { return m_state->source.get_token(); }
+
+private:
+
+    std::shared_ptr<job_state> m_state;
+};
+
+/// What a running job sees: its stop token, cancellable waits and a way to
+/// spawn children that inherit its cancellation.
+class job_context
+{
+public:
+
+    job_context(job_runner& runner, std::shared_ptr<job_state> self) noexcept
+        : m_runner{ runner }
+        , m_self{ std::move(self) }
+    { }
+
+    auto
+    get_stop_token() const noexcept -> std::stop_token
+    { return m_self->source.get_token(); }
+
+    auto
+    stop_requested() const noexcept -> bool
+    { return m_self->source.stop_requested(); }
+
+    /// Waits on `cv` until `pred` holds or the job is cancelled. The wait is
+    /// woken by the cancellation itself through `std::stop_callback`.
+    template<typename Lock, typename Predicate>
+    auto
+    wait(std::condition_variable_any& cv, Lock& lk, Predicate pred) const -> bool
+    { return cv.wait(lk, get_stop_token(), std::move(pred)); }
+
+    /// Waits while `counter` equals `old`. Returns `false` if cancelled.
+    auto
+    wait(const stop_aware_counter& counter, stop_aware_counter::value_type old) const noexcept -> bool
+    { return counter.wait(old, get_stop_token()); }
+
+    /// Submits a child job; cancelling this job cancels the child.
+    template<typename F>
+    auto spawn(F&& f) -> job_handle;
+
+    template<typename F>
+    auto spawn(F&& f, std::chrono::steady_clock::duration timeout) -> job_handle;
+
+private:
+
+    job_runner& m_runner;
+    std::shared_ptr<job_state> m_self;
+};
+
+/// Pool of workers running cancellable jobs with optional deadlines.
+///
+/// Every job owns a `std::stop_source`. Jobs spawned from inside another job
+/// link their source to the parent's token, so cancelling (or timing out) a
+/// job cancels its whole subtree, and the runner's own stop cancels
+/// everything. Deadlines are kept on a single `timer_wheel` thread which
+/// simply requests stop on the job's source when it fires.
+class job_runner
+{
+public:
+
+    explicit
+    job_runner(std::size_t workers = std::thread::hardware_concurrency(),
+               std::chrono::microseconds resolution = std::chrono::milliseconds{ 1 })
+        : m_timers{ resolution }
+    {
+        auto count = workers ? workers : 1;
+        m_workers.reserve(count);
+        for (auto i = std::size_t{ 0 }; i < count; ++i)
+            m_workers.emplace_back([this](std::stop_token tkn) { _M_work(tkn); });
+    }
+
+    job_runner(const job_runner&) = delete;
+    auto operator= (const job_runner&) -> job_runner& = delete;
+
+    /// Cancels every outstanding job, waits for running ones to return and
+    /// discards queued ones.
+    ~job_runner() noexcept
+    {
+        m_root.request_stop();
+        for (auto& w : m_workers)
+            w.request_stop();
+        m_workers.clear();
+
+        for (auto& state : m_queue)
+        {
+            state->done.store(true, std::memory_order_release);
+            state->done.notify_all();
+        }
+    }
+
+    template<typename F>
+    auto
+    submit(F&& f) -> job_handle
+    { return _M_submit(std::forward<F>(f), m_root.get_token(), std::nullopt); }
+
+    /// Submits a job that is cancelled if still running after `timeout`.
+    template<typename F>
+    auto
+    submit(F&& f, std::chrono::steady_clock::duration timeout) -> job_handle
+    { return _M_submit(std::forward<F>(f), m_root.get_token(), timeout); }
+
+    /// Cancels every job submitted to this runner.
+    auto
+    cancel_all() noexcept -> void
+    { m_root.request_stop(); }
+
+    auto
+    timers() const noexcept -> const timer_wheel&
+    { return m_timers; }
+
+private:
+
+    friend class job_context;
+
+    template<typename F>
+    auto
+    _M_submit(F&& f,
+              std::stop_token parent,
+              std::optional<std::chrono::steady_clock::duration> timeout) -> job_handle
+    {
+        auto state = std::make_shared<job_state>();
+        state->body = std::forward<F>(f);
+        state->parent_link.emplace(parent, job_state::forward_stop{ state->source });
+
+        if (timeout)
+            m_timers.schedule(*timeout, [weak = std::weak_ptr<job_state>{ state }]()
+            {
+                if (auto s = weak.lock(); s && !s->done.load(std::memory_order_acquire))
+                {
+                    s->timed_out.store(true, std::memory_order_release);
+                    s->source.request_stop();
+                }
+            });
+
+        {
+            auto lk = std::lock_guard{ m_mx };
+            m_queue.push_back(state);
+        }
+        m_cv.notify_one();
+
+        return job_handle{ std::move(state) };
+    }
+
+    auto
+    _M_work(std::stop_token tkn) -> void
+    {
+        while (true)
+        {
+            auto state = std::shared_ptr<job_state>{};
+            {
+                auto lk = std::unique_lock{ m_mx };
+                if (!m_cv.wait(lk, tkn, [this]() { return !m_queue.empty(); }))
+                    return;
+
+                state = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            /// Jobs cancelled while queued never start.
+            if (!state->source.stop_requested())
+            {
+                auto ctx = job_context{ *this, state };
+                state->body(ctx);
+            }
+
+            state->body = nullptr;
+            state->done.store(true, std::memory_order_release);
+            state->done.notify_all();
+        }
+    }
+
+    timer_wheel m_timers;
+    std::stop_source m_root;
+
+    std::mutex m_mx;
+    std::condition_variable_any m_cv;
+    std::deque<std::shared_ptr<job_state>> m_queue;
+
+    std::vector<std::jthread> m_workers;
+};
+
+template<typename F>
+auto
+job_context::spawn(F&& f) -> job_handle
+{ return m_runner._M_submit(std::forward<F>(f), get_stop_token(), std::nullopt); }
+
+template<typename F>
+auto
+job_context::spawn(F&& f, std::chrono::steady_clock::duration timeout) -> job_handle
+{ return m_runner._M_submit(std::forward<F>(f), get_stop_token(), timeout); }
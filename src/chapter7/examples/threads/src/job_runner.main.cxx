@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "job_runner.hxx"
+
+using namespace std::literals;
+using steady = std::chrono::steady_clock;
+
+constexpr auto trials           = 50u;
+constexpr auto poll_interval    = 10ms;
+constexpr auto pending_timers   = 100'000u;
+
+auto to_us(steady::duration d) -> double
+{ return std::chrono::duration<double, std::micro>(d).count(); }
+
+struct summary
+{
+    double mean;
+    double p50;
+    double max;
+};
+
+auto summarise(std::vector<double> v) -> summary
+{
+    std::ranges::sort(v);
+    return summary{ std::accumulate(v.begin(), v.end(), 0.0) / v.size(), v[v.size() / 2], v.back() };
+}
+
+auto print(const std::string& name, const summary& s) -> void
+{
+    std::cout << "| " << std::left << std::setw(34) << name << std::right << " | "
+              << std::setw(10) << s.mean << " | " << std::setw(10) << s.p50 << " | " << std::setw(10) << s.max << " |" << std::endl;
+}
+
+/// Cancels a job that is blocked `wait_time` after it was submitted and
+/// returns the time from `cancel()` until the job noticed.
+template<typename Body>
+auto cancellation_latency(job_runner& runner, Body body) -> std::vector<double>
+{
+    auto latencies = std::vector<double>{};
+    for (auto t { 0u }; t < trials; ++t)
+    {
+        auto woke = std::atomic<steady::rep>{ 0 };
+        auto job = runner.submit([&](job_context& ctx)
+        {
+            body(ctx);
+            woke.store(steady::now().time_since_epoch().count());
+        });
+
+        std::this_thread::sleep_for(2ms);
+        auto start = steady::now();
+        job.cancel();
+        job.wait();
+        latencies.push_back(to_us(steady::duration{ woke.load() } - start.time_since_epoch()));
+    }
+    return latencies;
+}
+
+auto main() -> int
+{
+    auto runner = job_runner{ 4 };
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "+------------------------------------+------------+------------+------------+" << std::endl;
+    std::cout << "| Cancellation latency               |  mean (us) |  p50 (us)  |  max (us)  |" << std::endl;
+    std::cout << "+------------------------------------+------------+------------+------------+" << std::endl;
+
+    /// The `jthread.main.cxx` pattern: sleep, then poll the token.
+    print("poll every 10ms", summarise(cancellation_latency(runner, [](job_context& ctx)
+    {
+        while (!ctx.stop_requested())
+            std::this_thread::sleep_for(poll_interval);
+    })));
+
+    auto mx = std::mutex{};
+    auto cv = std::condition_variable_any{};
+    print("condition_variable_any + token", summarise(cancellation_latency(runner, [&](job_context& ctx)
+    {
+        auto lk = std::unique_lock{ mx };
+        ctx.wait(cv, lk, []() { return false; });
+    })));
+
+    auto counter = stop_aware_counter{ 0 };
+    print("stop_aware_counter", summarise(cancellation_latency(runner, [&](job_context& ctx)
+    { ctx.wait(counter, 0); })));
+
+    /// A parent blocked on its children; cancelling the parent must reach
+    /// every child.
+    print("parent + 3 nested children", summarise(cancellation_latency(runner, [&](job_context& ctx)
+    {
+        auto children = std::vector<job_handle>{};
+        for (auto i { 0 }; i < 3; ++i)
+            children.push_back(ctx.spawn([&](job_context& child) { child.wait(counter, 0); }));
+        for (auto& c : children)
+            c.wait();
+    })));
+    std::cout << "+------------------------------------+------------+------------+------------+" << std::endl;
+
+    /// Deadline accuracy: jobs block forever and rely on their timeout.
+    {
+        auto lateness = std::vector<double>{};
+        for (auto t { 0u }; t < trials; ++t)
+        {
+            auto timeout = 1ms + (t % 10) * 1ms;
+            auto woke = std::atomic<steady::rep>{ 0 };
+            auto start = steady::now();
+            auto job = runner.submit([&](job_context& ctx)
+            {
+                ctx.wait(counter, 0);
+                woke.store(steady::now().time_since_epoch().count());
+            }, timeout);
+            job.wait();
+            lateness.push_back(to_us(steady::duration{ woke.load() } - (start + timeout).time_since_epoch()));
+        }
+        print("deadline lateness (1ms wheel)", summarise(lateness));
+        std::cout << "+------------------------------------+------------+------------+------------+" << std::endl;
+    }
+
+    /// Timer overhead: park 100k far-off deadlines on the wheel and measure
+    /// submission cost and the wheel's per-tick work while they are pending.
+    {
+        auto plain = runner.submit([](job_context&) { });
+        plain.wait();
+
+        auto [plain_us, with_us] = std::pair{ 0.0, 0.0 };
+        {
+            auto start = steady::now();
+            auto handles = std::vector<job_handle>{};
+            handles.reserve(pending_timers);
+            for (auto i { 0u }; i < pending_timers; ++i)
+                handles.push_back(runner.submit([](job_context&) { }));
+            for (auto& h : handles)
+                h.wait();
+            plain_us = to_us(steady::now() - start) / pending_timers;
+        }
+
+        {
+            auto start = steady::now();
+            auto handles = std::vector<job_handle>{};
+            handles.reserve(pending_timers);
+            for (auto i { 0u }; i < pending_timers; ++i)
+                handles.push_back(runner.submit([](job_context&) { }, 60s));
+            for (auto& h : handles)
+                h.wait();
+            with_us = to_us(steady::now() - start) / pending_timers;
+        }
+
+        auto ticks_before = runner.timers().ticks();
+        auto busy_before = runner.timers().busy();
+        std::this_thread::sleep_for(500ms);
+        auto ticks = runner.timers().ticks() - ticks_before;
+        auto busy = runner.timers().busy() - busy_before;
+
+        std::cout << "Pending deadlines        : " << runner.timers().pending() << "\n";
+        std::cout << "Submit + run, no timeout : " << plain_us << " us/job\n";
+        std::cout << "Submit + run, timeout    : " << with_us << " us/job\n";
+        std::cout << "Timer wheel ticks        : " << ticks << " in 500ms\n";
+        std::cout << "Timer wheel work         : " << std::setprecision(2)
+                  << to_us(busy) / std::max<std::uint64_t>(ticks, 1) << " us/tick ("
+                  << 100.0 * to_us(busy) / 500'000.0 << "% of a core)" << std::endl;
+    }
+
+    return 0;
+}
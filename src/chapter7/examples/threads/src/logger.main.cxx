@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "async_logger.hxx"
+
+using namespace std::literals;
+
+constexpr auto messages_per_thread  = 200'000u;
+constexpr auto sample_every         = 16u;
+
+struct result
+{
+    double seconds;
+    std::vector<std::int64_t> latencies;    ///< Sampled caller-side ns per call
+};
+
+/// Each thread logs `messages_per_thread` messages through `log`, timing
+/// every `sample_every`th call from the caller's side.
+template<typename Log>
+auto run(unsigned thr_count, Log log) -> result
+{
+    auto samples = std::vector<std::vector<std::int64_t>>(thr_count);
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
+
+    for (auto t { 0u }; t < thr_count; ++t)
+        pool.emplace_back([&samples, &log, t]()
+        {
+            auto& local = samples[t];
+            local.reserve(messages_per_thread / sample_every + 1);
+            for (auto i { 0u }; i < messages_per_thread; ++i)
+            {
+                if (i % sample_every == 0)
+                {
+                    auto before = std::chrono::steady_clock::now();
+                    log(t, i);
+                    local.push_back((std::chrono::steady_clock::now() - before).count());
+                }
+                else
+                    log(t, i);
+            }
+        });
+
+    for (auto& th : pool)
+        th.join();
+
+    auto res = result{};
+    for (auto& s : samples)
+        res.latencies.insert(res.latencies.end(), s.begin(), s.end());
+    std::ranges::sort(res.latencies);
+    return res;
+}
+
+auto percentile(const std::vector<std::int64_t>& sorted, double p) -> std::int64_t
+{ return sorted.empty() ? 0 : sorted[static_cast<std::size_t>(p * (sorted.size() - 1))]; }
+
+auto print(unsigned thr_count, const std::string& name, const result& r) -> void
+{
+    auto total = static_cast<double>(thr_count) * messages_per_thread;
+    std::cout << "| " << std::setw(7) << thr_count << " | " << std::setw(14) << name << " | "
+              << std::setw(12) << total / r.seconds / 1e6 << " | "
+              << std::setw(8) << percentile(r.latencies, 0.50) << " | "
+              << std::setw(8) << percentile(r.latencies, 0.99) << " | "
+              << std::setw(9) << percentile(r.latencies, 0.999) << " |" << std::endl;
+}
+
+auto main() -> int
+{
+    auto max_threads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Messages go to /dev/null; latencies are caller-side, in ns.\n";
+    std::cout << "+---------+----------------+--------------+----------+----------+-----------+" << std::endl;
+    std::cout << "| Threads |     Logger     |  Mmsgs/sec   |   p50    |   p99    |   p99.9   |" << std::endl;
+    std::cout << "+---------+----------------+--------------+----------+----------+-----------+" << std::endl;
+
+    for (auto thr_count { 1u }; thr_count <= max_threads; thr_count = thr_count < max_threads && thr_count * 2 > max_threads ? max_threads : thr_count * 2)
+    {
+        {
+            auto sink = std::ofstream{ "/dev/null" };
+            auto start = std::chrono::steady_clock::now();
+            auto r = run(thr_count, [&sink](auto t, auto i)
+            { std::osyncstream(sink) << "Thread " << t << " is running job: " << i << " (" << 1.5 << " ms)\n"; });
+            r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            print(thr_count, "osyncstream", r);
+        }
+
+        {
+            auto fd = ::open("/dev/null", O_WRONLY);
+            auto start = std::chrono::steady_clock::now();
+            auto r = result{};
+            {
+                auto logger = async_logger{ fd };
+                r = run(thr_count, [&logger](auto t, auto i)
+                { logger.log("Thread ", t, " is running job: ", i, " (", 1.5, " ms)\n"); });
+            }   /// Destructor drains, so the time includes the last flush
+            r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            print(thr_count, "async_logger", r);
+            ::close(fd);
+        }
+
+        std::cout << "+---------+----------------+--------------+----------+----------+-----------+" << std::endl;
+
+        if (thr_count == max_threads)
+            break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+class stat_registry;
+
+/// Handle to a counter registered with a `stat_registry`. Cheap to copy and
+/// safe to use from any thread.
+class stat_counter
+{
+public:
+
+    constexpr
+    stat_counter(stat_registry& registry, std::size_t id) noexcept
+        : m_registry{ &registry }
+        , m_id{ id }
+    { }
+
+    auto add(std::int64_t n) const -> void;
+
+    auto
+    operator++ () const -> const stat_counter&
+    {
+        add(1);
+        return *this;
+    }
+
+    auto
+    operator+= (std::int64_t n) const -> const stat_counter&
+    {
+        add(n);
+        return *this;
+    }
+
+    constexpr auto
+    id() const noexcept -> std::size_t
+    { return m_id; }
+
+private:
+
+    stat_registry* m_registry;
+    std::size_t m_id;
+};
+
+/// Registry of shared statistics counters with thread-local accumulation.
+///
+/// Incrementing a shared atomic from every request handler makes each
+/// counter's cache line bounce between cores. Here increments go to a plain
+/// thread-local slot; every `flush_every` increments a thread publishes all
+/// of its dirty slots into the shared values with `std::atomic_ref`
+/// `fetch_add`. Readers see an eventually-consistent total that lags the
+/// true value by at most `flush_every` increments per writing thread (plus
+/// whatever a thread has accumulated since it last flushed, which is
+/// published when it calls `flush()` or exits).
+///
+/// Each shared value is padded to its own cache line, so threads flushing
+/// unrelated counters don't false-share. That costs 64 bytes per counter of
+/// `max_counters`.
+class stat_registry
+{
+public:
+
+    explicit
+    stat_registry(std::size_t max_counters = 1024, std::uint32_t flush_every = 1024)
+        : m_shared{ std::make_shared<shared>(max_counters) }
+        , m_flush_every{ flush_every ? flush_every : 1 }
+    { }
+
+    stat_registry(const stat_registry&) = delete;
+    auto operator= (const stat_registry&) -> stat_registry& = delete;
+
+    /// Registers a new counter. Throws `std::length_error` once
+    /// `max_counters` are registered.
+    auto
+    add(std::string name) -> stat_counter
+    {
+        auto lk = std::lock_guard{ m_shared->mx };
+        if (m_shared->names.size() == m_shared->capacity)
+            throw std::length_error("Registry Full");
+
+        m_shared->names.push_back(std::move(name));
+        return stat_counter{ *this, m_shared->names.size() - 1 };
+    }
+
+    /// Adds `n` to counter `id` on behalf of the calling thread.
+    auto
+    add(std::size_t id, std::int64_t n) -> void
+    {
+        auto& local = _M_local();
+        if (local.deltas[id] == 0)
+            local.dirty.push_back(id);
+        local.deltas[id] += n;
+
+        if (++local.ops >= m_flush_every)
+            local.flush();
+    }
+
+    /// Publishes the calling thread's pending increments.
+    auto
+    flush() -> void
+    { _M_local().flush(); }
+
+    /// Eventually-consistent value of counter `id`.
+    auto
+    value(std::size_t id) const noexcept -> std::int64_t
+    { return std::atomic_ref<std::int64_t>{ m_shared->values[id].value }.load(std::memory_order_relaxed); }
+
+    auto
+    value(const stat_counter& c) const noexcept -> std::int64_t
+    { return value(c.id()); }
+
+    /// Names and current values of every registered counter.
+    auto
+    snapshot() const -> std::vector<std::pair<std::string, std::int64_t>>
+    {
+        auto lk = std::lock_guard{ m_shared->mx };
+        auto result = std::vector<std::pair<std::string, std::int64_t>>{};
+        result.reserve(m_shared->names.size());
+        for (auto i = std::size_t{ 0 }; i < m_shared->names.size(); ++i)
+            result.emplace_back(m_shared->names[i], value(i));
+        return result;
+    }
+
+private:
+
+    static constexpr std::size_t cache_line = 64;
+
+    /// Outlives the registry while threads still hold local slots for it, so
+    /// a thread exiting after the registry is gone can still flush safely.
+    struct alignas(cache_line) slot
+    {
+        std::int64_t value { 0 };
+    };
+
+    struct shared
+    {
+        explicit
+        shared(std::size_t cap)
+            : capacity{ cap }
+            , values{ std::make_unique<slot[]>(cap) }
+        { }
+
+        std::size_t capacity;
+        std::unique_ptr<slot[]> values;
+        mutable std::mutex mx;
+        std::vector<std::string> names;
+    };
+
+    struct local_slots
+    {
+        std::shared_ptr<shared> target;
+        std::vector<std::int64_t> deltas;
+        std::vector<std::size_t> dirty;
+        std::uint32_t ops { 0 };
+
+        explicit
+        local_slots(std::shared_ptr<shared> s)
+            : target{ std::move(s) }
+            , deltas(target->capacity, 0)
+        { dirty.reserve(64); }
+
+        ~local_slots() noexcept
+        { flush(); }
+
+        auto
+        flush() noexcept -> void
+        {
+            for (auto id : dirty)
+            {
+                std::atomic_ref<std::int64_t>{ target->values[id].value }.fetch_add(deltas[id], std::memory_order_relaxed);
+                deltas[id] = 0;
+            }
+            dirty.clear();
+            ops = 0;
+        }
+    };
+
+    auto
+    _M_local() -> local_slots&
+    {
+        thread_local auto slots = std::vector<std::unique_ptr<local_slots>>{};
+
+        for (auto& s : slots)
+            if (s->target == m_shared)
+                return *s;
+
+        return *slots.emplace_back(std::make_unique<local_slots>(m_shared));
+    }
+
+    std::shared_ptr<shared> m_shared;
+    std::uint32_t m_flush_every;
+};
+
+inline auto
+stat_counter::add(std::int64_t n) const -> void
+{ m_registry->add(m_id, n); }
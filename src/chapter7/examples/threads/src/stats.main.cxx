@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stat_registry.hxx"
+
+constexpr auto counters             = 64u;
+constexpr auto increments_per_thread = 4'000'000u;
+
+/// Runs `thr_count` threads, each bumping the counters round-robin through
+/// `bump(thread, counter)`. Returns ns per increment from a thread's view.
+template<typename Bump>
+auto run(unsigned thr_count, Bump bump) -> double
+{
+    auto go = std::atomic<bool>{ false };
+    auto pool = std::vector<std::thread>();
+    pool.reserve(thr_count);
+
+    for (auto t { 0u }; t < thr_count; ++t)
+        pool.emplace_back([&go, &bump, t]()
+        {
+            go.wait(false, std::memory_order_acquire);
+            for (auto i { 0u }; i < increments_per_thread; ++i)
+                bump(t, i % counters);
+        });
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    go.notify_all();
+
+    for (auto& th : pool)
+        th.join();
+
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / increments_per_thread;
+}
+
+auto print(unsigned thr_count, const std::string& name, double ns, bool exact) -> void
+{
+    std::cout << "| " << std::setw(7) << thr_count << " | " << std::setw(20) << name << " | "
+              << std::setw(12) << ns << " | " << std::setw(7) << (exact ? "yes" : "NO") << " |" << std::endl;
+}
+
+auto main() -> int
+{
+    auto max_threads = std::max(std::thread::hardware_concurrency(), 2u);
+    auto expected = [](unsigned thr_count)
+    { return static_cast<std::int64_t>(thr_count) * increments_per_thread / counters; };
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << counters << " counters, " << increments_per_thread << " increments per thread.\n";
+    std::cout << "+---------+----------------------+--------------+---------+" << std::endl;
+    std::cout << "| Threads |       Counters       | ns/increment |  Exact  |" << std::endl;
+    std::cout << "+---------+----------------------+--------------+---------+" << std::endl;
+
+    for (auto thr_count { 1u }; thr_count <= max_threads; thr_count = thr_count < max_threads && thr_count * 2 > max_threads ? max_threads : thr_count * 2)
+    {
+        {
+            /// As in `thread.main.cxx`: `atomic_ref` over plain shared ints.
+            auto values = std::vector<std::int64_t>(counters, 0);
+            auto ns = run(thr_count, [&values](auto, auto c)
+            { std::atomic_ref<std::int64_t>{ values[c] }.fetch_add(1, std::memory_order_relaxed); });
+            auto exact = std::ranges::all_of(values, [&](auto v) { return v == expected(thr_count); });
+            print(thr_count, "atomic_ref fetch_add", ns, exact);
+        }
+
+        for (auto flush_every : { 64u, 1024u })
+        {
+            auto registry = stat_registry{ counters, flush_every };
+            auto handles = std::vector<stat_counter>{};
+            for (auto c { 0u }; c < counters; ++c)
+                handles.push_back(registry.add("counter." + std::to_string(c)));
+
+            auto ns = run(thr_count, [&handles](auto, auto c) { ++handles[c]; });
+            /// Worker threads flushed their remainder on exit.
+            auto exact = std::ranges::all_of(handles, [&](auto& h) { return registry.value(h) == expected(thr_count); });
+            print(thr_count, "registry / " + std::to_string(flush_every), ns, exact);
+        }
+
+        std::cout << "+---------+----------------------+--------------+---------+" << std::endl;
+
+        if (thr_count == max_threads)
+            break;
+    }
+
+    return 0;
+}
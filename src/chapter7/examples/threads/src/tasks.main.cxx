@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "unique_task.hxx"
+
+/// Every allocation in the process goes through here so a run can report
+/// how many allocations it made per task.
+static auto allocations = std::atomic<std::uint64_t>{ 0 };
+
+auto operator new(std::size_t n) -> void*
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void* p) noexcept -> void
+{ std::free(p); }
+
+auto operator delete(void* p, std::size_t) noexcept -> void
+{ std::free(p); }
+
+static constexpr auto tasks_per_run = std::size_t{ 1'000'000 };
+
+/// Minimal pool: one mutex-guarded queue of `Task`s drained by workers.
+/// The queue's own block allocations show up as a small constant in every
+/// row.
+template <typename Task>
+class task_pool
+{
+public:
+
+    explicit
+    task_pool(unsigned threads)
+    {
+        for (auto i = 0u; i < threads; ++i)
+            m_workers.emplace_back([this](std::stop_token tkn) { _M_work(tkn); });
+    }
+
+    ~task_pool() noexcept
+    {
+        for (auto& w : m_workers)
+            w.request_stop();
+        m_cv.notify_all();
+    }
+
+    auto
+    submit(Task task) -> void
+    {
+        {
+            auto lk = std::lock_guard{ m_mx };
+            m_queue.push_back(std::move(task));
+        }
+        m_cv.notify_one();
+    }
+
+private:
+
+    auto
+    _M_work(std::stop_token tkn) -> void
+    {
+        while (true)
+        {
+            auto task = Task{};
+            {
+                auto lk = std::unique_lock{ m_mx };
+                if (!m_cv.wait(lk, tkn, [this] { return !m_queue.empty(); }))
+                    return;
+                task = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex m_mx;
+    std::condition_variable_any m_cv;
+    std::deque<Task> m_queue;
+    std::vector<std::jthread> m_workers;
+};
+
+struct run_result
+{
+    double per_second;
+    double allocations_per_task;
+};
+
+/// Submits `tasks_per_run` jobs made by `make(i, done)` and waits until every
+/// one has run.
+template <typename Task, typename Make>
+auto run(Make make) -> run_result
+{
+    auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+    auto done = std::atomic<std::size_t>{ 0 };
+    auto pool = task_pool<Task>{ threads };
+
+    auto before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto i = std::size_t{ 0 }; i < tasks_per_run; ++i)
+        pool.submit(make(i, done));
+
+    while (done.load(std::memory_order_acquire) != tasks_per_run)
+        std::this_thread::yield();
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto allocs = allocations.load() - before;
+
+    return { static_cast<double>(tasks_per_run) / elapsed, static_cast<double>(allocs) / static_cast<double>(tasks_per_run) };
+}
+
+auto print(const char* wrapper, const char* callable, run_result r) -> void
+{
+    std::cout << "| " << std::left << std::setw(29) << wrapper
+              << " | " << std::setw(18) << callable << std::right
+              << " | " << std::setw(14) << static_cast<std::uint64_t>(r.per_second) << " | "
+              << std::setw(10) << r.allocations_per_task << " |" << std::endl;
+    std::cout << "+-------------------------------+--------------------+----------------+------------+" << std::endl;
+}
+
+/// Lambdas capturing the counter plus `Bytes` of payload.
+template <std::size_t Bytes>
+auto make_job(std::size_t i, std::atomic<std::size_t>& done)
+{
+    if constexpr (Bytes == 0)
+        return [&done]() { done.fetch_add(1, std::memory_order_release); };
+    else
+    {
+        auto payload = std::array<std::uint8_t, Bytes>{};
+        payload[0] = static_cast<std::uint8_t>(i);
+        return [payload, &done]() { done.fetch_add(1 + payload[0] / 256, std::memory_order_release); };
+    }
+}
+
+auto main() -> int
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Tasks per run: " << tasks_per_run << std::endl;
+    std::cout << "+-------------------------------+--------------------+----------------+------------+" << std::endl;
+    std::cout << "| Wrapper                       | Callable           |    Tasks / sec | Allocs/task|" << std::endl;
+    std::cout << "+-------------------------------+--------------------+----------------+------------+" << std::endl;
+
+    using function_t = std::function<void()>;
+    using task_t = unique_task<void()>;
+
+    print("std::function<void()>", "lambda,  8 bytes", run<function_t>([](auto i, auto& d) { return function_t{ make_job<0>(i, d) }; }));
+    print("std::function<void()>", "lambda, 40 bytes", run<function_t>([](auto i, auto& d) { return function_t{ make_job<32>(i, d) }; }));
+    print("std::packaged_task<void()>", "lambda,  8 bytes", run<std::packaged_task<void()>>([](auto i, auto& d) { return std::packaged_task<void()>{ make_job<0>(i, d) }; }));
+    print("unique_task<void()>", "lambda,  8 bytes", run<task_t>([](auto i, auto& d) { return task_t{ make_job<0>(i, d) }; }));
+    print("unique_task<void()>", "lambda, 40 bytes", run<task_t>([](auto i, auto& d) { return task_t{ make_job<32>(i, d) }; }));
+    print("unique_task<void()>", "lambda, 136 bytes", run<task_t>([](auto i, auto& d) { return task_t{ make_job<128>(i, d) }; }));
+    print("unique_task<void()>", "packaged_task", run<task_t>([](auto i, auto& d) { return task_t{ std::packaged_task<void()>{ make_job<0>(i, d) } }; }));
+    print("unique_task<void()>", "move-only lambda", run<task_t>([](auto i, auto& d)
+    {
+        return task_t{ [p = std::make_unique<std::size_t>(i), &d]() { d.fetch_add(1 + *p / tasks_per_run, std::memory_order_release); } };
+    }));
+
+    return 0;
+}
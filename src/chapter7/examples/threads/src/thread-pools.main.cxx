@@ -1,13 +1,18 @@
 #include <chrono>
 #include <iostream>
+#include <string>
 #include <syncstream>
 #include <thread>
 #include <vector>
 
+#include "trace.hxx"
+
 using namespace std::literals;
 
 auto job = [](auto job_id)
 { 
+    TRACE_THREAD_NAME("job " + std::to_string(job_id));
+    TRACE_SCOPE("task", "job");
     std::this_thread::sleep_for(150ms);
     std::osyncstream(std::cout) << "Thread: " 
                                 << std::this_thread::get_id()
@@ -21,6 +26,7 @@ auto main() -> int
 {    
     auto thr_count { std::thread::hardware_concurrency() };
     auto pool = std::vector<std::thread>();
+    TRACE_THREAD_NAME("main");
 
     /// Queue jobs
     for (auto i { 0u }; i < thr_count; ++i)
@@ -33,5 +39,7 @@ auto main() -> int
         if (th.joinable())
             th.join();
 
+    TRACE_DUMP("thread-pools.trace.json");
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// Hashed timing wheel driven by a single thread.
+///
+/// Deadlines are rounded up to the next `tick` and hashed into one of
+/// `slots` buckets; a bucket holds every timer due on a tick congruent to it,
+/// so timers further out than one revolution simply wait for later passes.
+/// Scheduling is O(1) (a push onto a mutex-guarded staging list) and each
+/// tick only visits one bucket, so the cost of a tick is independent of how
+/// many timers are pending elsewhere on the wheel.
+///
+/// Callbacks run on the wheel's thread and should be short, e.g. requesting
+/// stop on a `std::stop_source`.
+class timer_wheel
+{
+public:
+
+    using clock         = std::chrono::steady_clock;
+    using callback      = std::function<void()>;
+
+    explicit
+    timer_wheel(std::chrono::microseconds tick = std::chrono::milliseconds{ 1 }, std::size_t slots = 4096)
+        : m_tick{ tick }
+        , m_origin{ clock::now() }
+        , m_wheel(slots)
+        , m_thread{ [this](std::stop_token tkn) { _M_run(tkn); } }
+    { }
+
+    timer_wheel(const timer_wheel&) = delete;
+    auto operator= (const timer_wheel&) -> timer_wheel& = delete;
+
+    /// Pending timers are discarded without firing.
+    ~timer_wheel() noexcept = default;
+
+    auto
+    schedule(clock::time_point deadline, callback fn) -> void
+    {
+        auto lk = std::lock_guard{ m_staging_mx };
+        m_staging.push_back(entry{ _M_tick_of(deadline), std::move(fn) });
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto
+    schedule(clock::duration timeout, callback fn) -> void
+    { schedule(clock::now() + timeout, std::move(fn)); }
+
+    /// Timers scheduled but not yet fired.
+    auto
+    pending() const noexcept -> std::size_t
+    { return m_pending.load(std::memory_order_relaxed); }
+
+    /// Ticks processed and total time spent processing them, for measuring
+    /// the wheel's own overhead.
+    auto
+    ticks() const noexcept -> std::uint64_t
+    { return m_ticks.load(std::memory_order_relaxed); }
+
+    auto
+    busy() const noexcept -> std::chrono::nanoseconds
+    { return std::chrono::nanoseconds{ m_busy.load(std::memory_order_relaxed) }; }
+
+    constexpr auto
+    resolution() const noexcept -> std::chrono::microseconds
+    { return m_tick; }
+
+private:
+
+    struct entry
+    {
+        std::uint64_t tick;
+        callback fn;
+    };
+
+    /// Rounds up so a timer never fires early.
+    auto
+    _M_tick_of(clock::time_point t) const noexcept -> std::uint64_t
+    {
+        if (t <= m_origin)
+            return 0;
+
+        auto since = std::chrono::duration_cast<std::chrono::microseconds>(t - m_origin);
+        return static_cast<std::uint64_t>((since + m_tick - std::chrono::microseconds{ 1 }) / m_tick);
+    }
+
+    auto
+    _M_run(std::stop_token tkn) -> void
+    {
+        auto current = std::uint64_t{ 0 };
+        auto staged = std::vector<entry>{};
+        auto due = std::vector<callback>{};
+
+        while (!tkn.stop_requested())
+        {
+            std::this_thread::sleep_until(m_origin + m_tick * static_cast<std::int64_t>(current + 1));
+            auto start = clock::now();
+            auto now = static_cast<std::uint64_t>((start - m_origin) / m_tick);
+
+            {
+                auto lk = std::lock_guard{ m_staging_mx };
+                staged.swap(m_staging);
+            }
+
+            for (auto& e : staged)
+            {
+                /// Already overdue timers fire on this pass.
+                auto tick = e.tick <= current ? current + 1 : e.tick;
+                m_wheel[tick % m_wheel.size()].push_back(entry{ tick, std::move(e.fn) });
+            }
+            staged.clear();
+
+            /// Catch up on every tick that passed while we slept.
+            for (; current < now; )
+            {
+                ++current;
+                auto& bucket = m_wheel[current % m_wheel.size()];
+                auto kept = std::size_t{ 0 };
+                for (auto& e : bucket)
+                {
+                    if (e.tick <= current)
+                        due.push_back(std::move(e.fn));
+                    else
+                        bucket[kept++] = std::move(e);
+                }
+                bucket.resize(kept);
+            }
+
+            for (auto& fn : due)
+                fn();
+            m_pending.fetch_sub(due.size(), std::memory_order_relaxed);
+            due.clear();
+
+            m_ticks.fetch_add(1, std::memory_order_relaxed);
+            auto spent = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+            m_busy.fetch_add(spent.count(), std::memory_order_relaxed);
+        }
+    }
+
+    std::chrono::microseconds m_tick;
+    clock::time_point m_origin;
+    std::vector<std::vector<entry>> m_wheel;
+
+    std::mutex m_staging_mx;
+    std::vector<entry> m_staging;
+
+    std::atomic<std::size_t> m_pending { 0 };
+    std::atomic<std::uint64_t> m_ticks { 0 };
+    std::atomic<std::int64_t> m_busy { 0 };
+
+    std::jthread m_thread;
+};
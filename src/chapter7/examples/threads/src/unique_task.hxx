@@ -0,0 +1,184 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, std::size_t Capacity = 48>
+class unique_task;
+
+/// Move-only type-erased callable with an inline buffer, for handing jobs to
+/// a pool.
+///
+/// Unlike `std::function` it can hold move-only callables (a lambda owning a
+/// `std::unique_ptr`, a `std::packaged_task`), and any callable of at most
+/// `Capacity` bytes whose move constructor does not throw is constructed
+/// directly in the task itself, so wrapping and moving it through a queue
+/// never allocates. Larger callables fall back to one heap allocation,
+/// after which moving the task is a pointer copy.
+///
+/// Dispatch goes through a static table of three function pointers per
+/// callable type (invoke, relocate, destroy) rather than a virtual base.
+/// Note that `std::packaged_task` itself is stored inline but still
+/// allocates its shared state when it is created.
+template <typename R, typename... Args, std::size_t Capacity>
+class unique_task<R(Args...), Capacity>
+{
+    static_assert(Capacity >= sizeof(void*), "Buffer Must Hold A Pointer");
+
+public:
+
+    using result_type = R;
+
+    /// Whether `F` is stored in the inline buffer.
+    template <typename F>
+    static constexpr bool is_inline = sizeof(F) <= Capacity
+                                   && alignof(F) <= alignof(std::max_align_t)
+                                   && std::is_nothrow_move_constructible_v<F>;
+
+    unique_task() noexcept = default;
+
+    unique_task(std::nullptr_t) noexcept { }
+
+    template <typename F>
+        requires (!std::same_as<std::remove_cvref_t<F>, unique_task>)
+              && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>
+              && std::is_constructible_v<std::decay_t<F>, F>
+    unique_task(F&& f)
+    {
+        using fn_type = std::decay_t<F>;
+
+        if constexpr (is_inline<fn_type>)
+            ::new (static_cast<void*>(m_storage)) fn_type(std::forward<F>(f));
+        else
+            ::new (static_cast<void*>(m_storage)) fn_type*(new fn_type(std::forward<F>(f)));
+
+        m_ops = &s_ops<fn_type>;
+    }
+
+    unique_task(const unique_task&) = delete;
+    auto operator= (const unique_task&) -> unique_task& = delete;
+
+    unique_task(unique_task&& other) noexcept
+    { _M_take(other); }
+
+    auto
+    operator= (unique_task&& other) noexcept -> unique_task&
+    {
+        if (this != &other)
+        {
+            reset();
+            _M_take(other);
+        }
+
+        return *this;
+    }
+
+    ~unique_task() noexcept
+    { reset(); }
+
+    auto
+    operator() (Args... args) -> R
+    { return m_ops->invoke(m_storage, std::forward<Args>(args)...); }
+
+    explicit
+    operator bool() const noexcept
+    { return m_ops != nullptr; }
+
+    /// Destroys the held callable, if any.
+    auto
+    reset() noexcept -> void
+    {
+        if (m_ops)
+            m_ops->destroy(m_storage);
+        m_ops = nullptr;
+    }
+
+    auto
+    swap(unique_task& other) noexcept -> void
+    {
+        auto tmp = std::move(other);
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+
+    struct ops
+    {
+        R (*invoke)(void*, Args&&...);
+        void (*relocate)(void* from, void* to) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template <typename F>
+    static auto
+    _S_get(void* p) noexcept -> F&
+    {
+        if constexpr (is_inline<F>)
+            return *std::launder(static_cast<F*>(p));
+        else
+            return **std::launder(static_cast<F**>(p));
+    }
+
+    template <typename F>
+    static constexpr auto s_ops = ops
+    {
+        [](void* p, Args&&... args) -> R
+        {
+            if constexpr (std::is_void_v<R>)
+                std::invoke(_S_get<F>(p), std::forward<Args>(args)...);
+            else
+                return std::invoke(_S_get<F>(p), std::forward<Args>(args)...);
+        },
+
+        [](void* from, void* to) noexcept
+        {
+            if constexpr (is_inline<F>)
+            {
+                auto& f = _S_get<F>(from);
+                ::new (to) F(std::move(f));
+                f.~F();
+            }
+            else
+                ::new (to) F*(*static_cast<F**>(from));
+        },
+
+        [](void* p) noexcept
+        {
+            if constexpr (is_inline<F>)
+                _S_get<F>(p).~F();
+            else
+                delete *static_cast<F**>(p);
+        }
+    };
+
+    /// Moves `other`'s callable into the (empty) buffer, leaving `other`
+    /// empty.
+    auto
+    _M_take(unique_task& other) noexcept -> void
+    {
+        if (other.m_ops)
+        {
+            other.m_ops->relocate(other.m_storage, m_storage);
+            m_ops = std::exchange(other.m_ops, nullptr);
+        }
+    }
+
+    alignas(std::max_align_t) std::byte m_storage[Capacity];
+    const ops* m_ops { nullptr };
+};
+
+template <typename Signature, std::size_t Capacity>
+auto
+swap(unique_task<Signature, Capacity>& lhs, unique_task<Signature, Capacity>& rhs) noexcept -> void
+{ lhs.swap(rhs); }
+
+template <typename Signature, std::size_t Capacity>
+auto
+operator== (const unique_task<Signature, Capacity>& t, std::nullptr_t) noexcept -> bool
+{ return !t; }
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <execution>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Parallel least-significant-digit radix sort.
+///
+/// Every pass sorts on one 8-bit digit, stably, in three steps:
+///
+/// 1. The input is cut into one chunk per thread and every chunk counts its
+///    digits into its own histogram, so no counter is shared.
+/// 2. A prefix sum over (digit, chunk) gives every chunk the first output
+///    position of each of its digits.
+/// 3. Every chunk scatters its elements to those positions. Writing each
+///    element straight to one of 256 far-apart output streams misses the
+///    cache and TLB on nearly every store, so elements are first staged in
+///    a small per-digit buffer (a software write-combining buffer) and
+///    copied out a cache line at a time.
+///
+/// Passes in which every key has the same digit are skipped, so narrow key
+/// ranges cost fewer passes. Signed integers and floating-point keys are
+/// mapped to unsigned integers whose order matches (`radix_key`), sorted,
+/// and mapped back.
+
+/// Order-preserving map from a key to an unsigned integer of the same
+/// width: the sign bit of signed integers is flipped, negative floats have
+/// every bit flipped and non-negative floats just the sign bit. `-0.0`
+/// sorts before `+0.0`, NaNs sort by their bit pattern at the ends.
+template <typename T>
+struct radix_key;
+
+template <std::unsigned_integral T>
+struct radix_key<T>
+{
+    using bits_type = T;
+
+    static constexpr auto encode(T v) noexcept -> bits_type { return v; }
+    static constexpr auto decode(bits_type b) noexcept -> T { return b; }
+};
+
+template <std::signed_integral T>
+struct radix_key<T>
+{
+    using bits_type = std::make_unsigned_t<T>;
+    static constexpr bits_type sign = bits_type{ 1 } << (sizeof(T) * 8 - 1);
+
+    static constexpr auto encode(T v) noexcept -> bits_type { return static_cast<bits_type>(v) ^ sign; }
+    static constexpr auto decode(bits_type b) noexcept -> T { return static_cast<T>(b ^ sign); }
+};
+
+template <std::floating_point T>
+    requires (sizeof(T) == 4 || sizeof(T) == 8)
+struct radix_key<T>
+{
+    using bits_type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    static constexpr bits_type sign = bits_type{ 1 } << (sizeof(T) * 8 - 1);
+
+    static constexpr auto
+    encode(T v) noexcept -> bits_type
+    {
+        auto b = std::bit_cast<bits_type>(v);
+        return (b & sign) ? ~b : (b | sign);
+    }
+
+    static constexpr auto
+    decode(bits_type b) noexcept -> T
+    { return std::bit_cast<T>((b & sign) ? (b ^ sign) : ~b); }
+};
+
+template <typename T>
+concept radix_sortable = requires { typename radix_key<T>::bits_type; };
+
+namespace radix_detail
+{
+    inline constexpr auto radix       = std::size_t{ 256 };
+    inline constexpr auto cache_line  = std::size_t{ 64 };
+    inline constexpr auto min_chunk   = std::size_t{ 1 } << 16;
+
+    /// Elements staged per digit before a flush: one cache line's worth.
+    template <typename T>
+    inline constexpr auto wc_items = std::max(cache_line / sizeof(T), std::size_t{ 1 });
+
+    /// Per-chunk scatter state: output cursors plus the staging buffers for
+    /// keys and (optionally) values.
+    template <typename U, typename V>
+    struct alignas(cache_line) scatter_state
+    {
+        static constexpr auto key_items = wc_items<U>;
+
+        std::array<std::size_t, radix> pos;
+        std::array<std::uint8_t, radix> fill;
+        std::array<std::array<U, key_items>, radix> keys;
+        std::conditional_t<std::is_void_v<V>, std::array<char, 0>, std::array<std::array<std::conditional_t<std::is_void_v<V>, char, V>, key_items>, radix>> values;
+    };
+
+    /// Moves a staging buffer out. Uses `memcpy` for trivially copyable
+    /// types and element-wise move assignment otherwise.
+    template <typename T>
+    auto
+    flush(T* from, T* to, std::size_t n) noexcept -> void
+    {
+        if constexpr (std::is_trivially_copyable_v<T>)
+            std::memcpy(to, from, n * sizeof(T));
+        else
+            std::move(from, from + n, to);
+    }
+
+    /// Sorts `keys`, permuting `values` (if any) the same way. `keys` and
+    /// `values` are ping-ponged with equally sized scratch buffers; the
+    /// result always ends in the original buffers.
+    template <std::unsigned_integral U, typename V = void>
+    auto
+    sort(std::span<U> keys, V* values = nullptr) -> void
+    {
+        using value_type = std::conditional_t<std::is_void_v<V>, char, V>;
+        constexpr auto has_values = !std::is_void_v<V>;
+        constexpr auto items = wc_items<U>;
+
+        auto n = keys.size();
+        if (n < 2)
+            return;
+
+        auto threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        auto chunks = std::clamp<std::size_t>(n / min_chunk, 1, threads);
+        auto per_chunk = (n + chunks - 1) / chunks;
+
+        /// Chunk indices live in a vector: the parallel algorithms run a
+        /// `std::views::iota` range on the calling thread.
+        auto cs = std::vector<std::size_t>(chunks);
+        std::iota(cs.begin(), cs.end(), std::size_t{ 0 });
+
+        auto key_tmp = std::vector<U>(n);
+        auto value_tmp = std::vector<value_type>(has_values ? n : 0);
+        auto states = std::make_unique<scatter_state<U, V>[]>(chunks);
+
+        U* src_keys = keys.data();
+        U* dst_keys = key_tmp.data();
+        value_type* src_values = nullptr;
+        value_type* dst_values = nullptr;
+        if constexpr (has_values)
+        {
+            src_values = values;
+            dst_values = value_tmp.data();
+        }
+
+        auto swapped = false;
+        for (auto shift = std::size_t{ 0 }; shift < sizeof(U) * 8; shift += 8)
+        {
+            auto digit = [shift](U k) { return static_cast<std::size_t>((k >> shift) & 0xff); };
+
+            std::for_each(std::execution::par, cs.begin(), cs.end(), [&](std::size_t c)
+            {
+                auto& h = states[c].pos;
+                h.fill(0);
+                auto last = std::min(n, (c + 1) * per_chunk);
+                for (auto i = c * per_chunk; i < last; ++i)
+                    ++h[digit(src_keys[i])];
+            });
+
+            auto uniform = false;
+            for (auto d = std::size_t{ 0 }; d < radix && !uniform; ++d)
+            {
+                auto total = std::size_t{ 0 };
+                for (auto c = std::size_t{ 0 }; c < chunks; ++c)
+                    total += states[c].pos[d];
+                uniform = total == n;
+            }
+            if (uniform)
+                continue;
+
+            auto offset = std::size_t{ 0 };
+            for (auto d = std::size_t{ 0 }; d < radix; ++d)
+                for (auto c = std::size_t{ 0 }; c < chunks; ++c)
+                    offset += std::exchange(states[c].pos[d], offset);
+
+            std::for_each(std::execution::par, cs.begin(), cs.end(), [&](std::size_t c)
+            {
+                auto& s = states[c];
+                s.fill.fill(0);
+
+                auto last = std::min(n, (c + 1) * per_chunk);
+                for (auto i = c * per_chunk; i < last; ++i)
+                {
+                    auto d = digit(src_keys[i]);
+                    auto f = s.fill[d]++;
+                    s.keys[d][f] = src_keys[i];
+                    if constexpr (has_values)
+                        s.values[d][f] = std::move(src_values[i]);
+
+                    if (f + 1 == items)
+                    {
+                        flush(s.keys[d].data(), dst_keys + s.pos[d], items);
+                        if constexpr (has_values)
+                            flush(s.values[d].data(), dst_values + s.pos[d], items);
+                        s.pos[d] += items;
+                        s.fill[d] = 0;
+                    }
+                }
+
+                for (auto d = std::size_t{ 0 }; d < radix; ++d)
+                {
+                    flush(s.keys[d].data(), dst_keys + s.pos[d], s.fill[d]);
+                    if constexpr (has_values)
+                        flush(s.values[d].data(), dst_values + s.pos[d], s.fill[d]);
+                }
+            });
+
+            std::swap(src_keys, dst_keys);
+            std::swap(src_values, dst_values);
+            swapped = !swapped;
+        }
+
+        if (swapped)
+        {
+            std::copy(std::execution::par_unseq, key_tmp.begin(), key_tmp.end(), keys.begin());
+            if constexpr (has_values)
+                std::move(std::execution::par_unseq, value_tmp.begin(), value_tmp.end(), values);
+        }
+    }
+
+    /// Encodes `[first, last)` into a buffer of key bits.
+    template <typename It>
+    auto
+    encode(It first, It last) -> std::vector<typename radix_key<std::iter_value_t<It>>::bits_type>
+    {
+        using traits = radix_key<std::iter_value_t<It>>;
+        auto bits = std::vector<typename traits::bits_type>(static_cast<std::size_t>(last - first));
+        std::transform(std::execution::par_unseq, first, last, bits.begin(), [](auto v) { return traits::encode(v); });
+        return bits;
+    }
+
+    template <typename It, typename U>
+    auto
+    decode(const std::vector<U>& bits, It first) -> void
+    {
+        using traits = radix_key<std::iter_value_t<It>>;
+        std::transform(std::execution::par_unseq, bits.begin(), bits.end(), first, [](U b) { return traits::decode(b); });
+    }
+}
+
+/// Sorts `[first, last)` in ascending order.
+template <std::random_access_iterator It>
+    requires radix_sortable<std::iter_value_t<It>>
+auto
+radix_sort(It first, It last) -> void
+{
+    using T = std::iter_value_t<It>;
+
+    if constexpr (std::unsigned_integral<T> && std::contiguous_iterator<It>)
+        radix_detail::sort(std::span<T>{ std::to_address(first), static_cast<std::size_t>(last - first) });
+    else
+    {
+        auto bits = radix_detail::encode(first, last);
+        radix_detail::sort(std::span{ bits });
+        radix_detail::decode(bits, first);
+    }
+}
+
+template <std::ranges::random_access_range R>
+    requires radix_sortable<std::ranges::range_value_t<R>>
+auto
+radix_sort(R&& r) -> void
+{ radix_sort(std::ranges::begin(r), std::ranges::end(r)); }
+
+/// Sorts `keys` and applies the same permutation to `values`. Stable:
+/// values with equal keys keep their relative order.
+template <radix_sortable K, typename V>
+    requires std::is_nothrow_move_assignable_v<V> && std::is_default_constructible_v<V>
+auto
+radix_sort(std::span<K> keys, std::span<V> values) -> void
+{
+    if (keys.size() != values.size())
+        throw std::length_error("Size Mismatch");
+
+    if constexpr (std::unsigned_integral<K>)
+        radix_detail::sort(keys, values.data());
+    else
+    {
+        auto bits = radix_detail::encode(keys.begin(), keys.end());
+        radix_detail::sort(std::span{ bits }, values.data());
+        radix_detail::decode(bits, keys.begin());
+    }
+}
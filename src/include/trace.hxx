@@ -0,0 +1,378 @@
+#pragma once
+
+/// Timeline tracing for threads, tasks and locks, written as Chrome trace
+/// JSON (open it in https://ui.perfetto.dev or `chrome://tracing`).
+///
+/// Tracing is compiled in only when `TRACE_ENABLED` is defined (add
+/// `-DTRACE_ENABLED` to the build flags). Otherwise every `TRACE_*` macro
+/// expands to nothing, or to just the wrapped expression, so instrumented
+/// code is identical to uninstrumented code.
+///
+///     TRACE_THREAD_NAME("worker");
+///     {
+///         TRACE_SCOPE("task", "job");                     // span to end of scope
+///         TRACE_WAIT("barrier", "arrive_and_wait", barrier.arrive_and_wait());
+///         TRACE_INSTANT("task", "done");
+///     }
+///     TRACE_DUMP("barrier.trace.json");
+///
+/// and `traced_mutex<M>` records the time spent waiting for and holding a
+/// lock. Each thread writes to its own fixed-size buffer, so recording an
+/// event is a timestamp, a few stores and one release store, with no shared
+/// writes. When a buffer fills, later events on that thread are dropped and
+/// counted. Define `TRACE_BUFFER_EVENTS` to change the per-thread capacity.
+///
+/// Timestamps come from `steady_clock`, or from `rdtsc` on x86 when
+/// `TRACE_RDTSC` is defined. TSC ticks are converted to time at dump, by
+/// calibrating against `steady_clock` over the whole run, which assumes an
+/// invariant TSC.
+
+#if defined(TRACE_ENABLED)
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(TRACE_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #define TRACE_USE_TSC 1
+#endif
+
+#ifndef TRACE_BUFFER_EVENTS
+#   define TRACE_BUFFER_EVENTS (std::size_t{ 1 } << 16)
+#endif
+
+namespace trace_detail
+{
+    inline auto
+    ticks() noexcept -> std::uint64_t
+    {
+#if defined(TRACE_USE_TSC)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    inline auto
+    steady_ns() noexcept -> std::uint64_t
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /// A complete span (`ph: X`) or, when `end == 0`, an instant (`ph: i`).
+    /// Names and categories must be string literals or otherwise outlive
+    /// the dump.
+    struct event
+    {
+        const char* category;
+        const char* name;
+        std::uint64_t begin;
+        std::uint64_t end;
+    };
+
+    /// One thread's events. Only the owning thread writes; `m_size` is
+    /// published with release so a dump on another thread sees complete
+    /// events.
+    class buffer
+    {
+    public:
+
+        buffer(std::size_t tid, std::size_t capacity)
+            : m_tid{ tid }
+            , m_events{ std::make_unique<event[]>(capacity) }
+            , m_capacity{ capacity }
+        { }
+
+        auto
+        push(const event& e) noexcept -> void
+        {
+            auto n = m_size.load(std::memory_order_relaxed);
+            if (n == m_capacity)
+            {
+                m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+            m_events[n] = e;
+            m_size.store(n + 1, std::memory_order_release);
+        }
+
+        auto
+        set_name(std::string name) -> void
+        {
+            auto lk = std::lock_guard{ m_name_mx };
+            m_name = std::move(name);
+        }
+
+        auto
+        name() const -> std::string
+        {
+            auto lk = std::lock_guard{ m_name_mx };
+            return m_name;
+        }
+
+        auto tid() const noexcept -> std::size_t { return m_tid; }
+        auto size() const noexcept -> std::size_t { return m_size.load(std::memory_order_acquire); }
+        auto dropped() const noexcept -> std::size_t { return m_dropped.load(std::memory_order_relaxed); }
+        auto operator[] (std::size_t i) const noexcept -> const event& { return m_events[i]; }
+
+    private:
+
+        std::size_t m_tid;
+        std::unique_ptr<event[]> m_events;
+        std::size_t m_capacity;
+        std::atomic<std::size_t> m_size { 0 };
+        std::atomic<std::size_t> m_dropped { 0 };
+        mutable std::mutex m_name_mx;
+        std::string m_name;
+    };
+
+    /// Owns every thread's buffer, so events survive their thread and can
+    /// be dumped after it is joined. Only registration and dumping lock.
+    class registry
+    {
+    public:
+
+        static auto
+        instance() -> registry&
+        {
+            static auto r = registry{};
+            return r;
+        }
+
+        auto
+        local() -> buffer&
+        {
+            thread_local auto* b = _M_register();
+            return *b;
+        }
+
+        auto
+        dump(const std::string& path) -> bool
+        {
+            auto lk = std::lock_guard{ m_mx };
+            auto os = std::ofstream{ path };
+            if (!os)
+                return false;
+
+            auto ticks_per_us = _M_ticks_per_us();
+            auto to_us = [&](std::uint64_t t)
+            { return static_cast<double>(t - m_origin_ticks) / ticks_per_us; };
+
+            os.precision(3);
+            os << std::fixed << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+            auto first = true;
+            auto sep = [&]() -> std::ofstream&
+            {
+                os << (first ? "\n" : ",\n");
+                first = false;
+                return os;
+            };
+
+            for (const auto& b : m_buffers)
+            {
+                auto name = b->name();
+                if (name.empty())
+                    name = "thread " + std::to_string(b->tid());
+                sep() << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << b->tid()
+                      << R"(,"args":{"name":")" << _S_escape(name) << "\"}}";
+
+                for (auto i = std::size_t{ 0 }, n = b->size(); i < n; ++i)
+                {
+                    const auto& e = (*b)[i];
+                    sep() << R"({"pid":1,"tid":)" << b->tid()
+                          << R"(,"cat":")" << _S_escape(e.category)
+                          << R"(","name":")" << _S_escape(e.name)
+                          << R"(","ts":)" << to_us(e.begin);
+                    if (e.end)
+                        os << R"(,"ph":"X","dur":)" << static_cast<double>(e.end - e.begin) / ticks_per_us << "}";
+                    else
+                        os << R"(,"ph":"i","s":"t"})";
+                }
+
+                if (auto dropped = b->dropped())
+                    sep() << R"({"ph":"i","s":"t","pid":1,"tid":)" << b->tid() << R"(,"cat":"trace","name":"dropped )"
+                          << dropped << R"( events","ts":)" << to_us(_S_last(*b)) << "}";
+            }
+
+            os << "\n]}\n";
+            return static_cast<bool>(os);
+        }
+
+    private:
+
+        registry()
+            : m_origin_ticks{ ticks() }
+            , m_origin_ns{ steady_ns() }
+        { }
+
+        auto
+        _M_register() -> buffer*
+        {
+            auto lk = std::lock_guard{ m_mx };
+            m_buffers.push_back(std::make_unique<buffer>(m_buffers.size(), TRACE_BUFFER_EVENTS));
+            return m_buffers.back().get();
+        }
+
+        /// Ticks per microsecond; measured over the run for the TSC.
+        auto
+        _M_ticks_per_us() const noexcept -> double
+        {
+#if defined(TRACE_USE_TSC)
+            auto ns = steady_ns() - m_origin_ns;
+            auto tsc = ticks() - m_origin_ticks;
+            return ns ? static_cast<double>(tsc) * 1e3 / static_cast<double>(ns) : 1.0;
+#else
+            return 1e3 * static_cast<double>(std::chrono::steady_clock::period::den)
+                / (1e9 * static_cast<double>(std::chrono::steady_clock::period::num));
+#endif
+        }
+
+        static auto
+        _S_last(const buffer& b) noexcept -> std::uint64_t
+        {
+            auto n = b.size();
+            if (!n)
+                return ticks();
+            const auto& e = b[n - 1];
+            return e.end ? e.end : e.begin;
+        }
+
+        static auto
+        _S_escape(std::string_view s) -> std::string
+        {
+            auto out = std::string{};
+            out.reserve(s.size());
+            for (auto c : s)
+            {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                if (static_cast<unsigned char>(c) < 0x20)
+                    out += ' ';
+                else
+                    out += c;
+            }
+            return out;
+        }
+
+        std::mutex m_mx;
+        std::vector<std::unique_ptr<buffer>> m_buffers;
+        std::uint64_t m_origin_ticks;
+        std::uint64_t m_origin_ns;
+    };
+}
+
+/// Records the time from construction to destruction as one span.
+class trace_span
+{
+public:
+
+    trace_span(const char* category, const char* name) noexcept
+        : m_category{ category }
+        , m_name{ name }
+        , m_begin{ trace_detail::ticks() }
+    { }
+
+    trace_span(const trace_span&) = delete;
+    auto operator= (const trace_span&) -> trace_span& = delete;
+
+    ~trace_span() noexcept
+    { trace_detail::registry::instance().local().push({ m_category, m_name, m_begin, trace_detail::ticks() }); }
+
+private:
+
+    const char* m_category;
+    const char* m_name;
+    std::uint64_t m_begin;
+};
+
+/// Wraps a BasicLockable, recording a "wait" span for every blocking
+/// `lock()` and a "hold" span from acquire to `unlock()`. Works with
+/// `std::lock_guard`, `std::unique_lock` and `std::scoped_lock`.
+template<typename Mutex>
+class traced_mutex : public Mutex
+{
+public:
+
+    explicit
+    traced_mutex(const char* name) noexcept
+        : m_name{ name }
+    { }
+
+    auto
+    lock() -> void
+    {
+        auto begin = trace_detail::ticks();
+        Mutex::lock();
+        m_acquired = trace_detail::ticks();
+        trace_detail::registry::instance().local().push({ "lock wait", m_name, begin, m_acquired });
+    }
+
+    auto
+    try_lock() -> bool
+    {
+        if (!Mutex::try_lock())
+            return false;
+        m_acquired = trace_detail::ticks();
+        return true;
+    }
+
+    auto
+    unlock() -> void
+    {
+        /// Read before releasing; the next owner overwrites it.
+        auto acquired = m_acquired;
+        Mutex::unlock();
+        trace_detail::registry::instance().local().push({ "lock hold", m_name, acquired, trace_detail::ticks() });
+    }
+
+private:
+
+    const char* m_name;
+    std::uint64_t m_acquired { 0 };
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#define TRACE_SCOPE(category, name) \
+    const auto TRACE_CONCAT(trace_span_, __LINE__) = trace_span{ category, name }
+#define TRACE_WAIT(category, name, ...) \
+    [&]() -> decltype(auto) { TRACE_SCOPE(category, name); return __VA_ARGS__; }()
+#define TRACE_INSTANT(category, name) \
+    trace_detail::registry::instance().local().push({ category, name, trace_detail::ticks(), 0 })
+#define TRACE_THREAD_NAME(...) \
+    trace_detail::registry::instance().local().set_name(__VA_ARGS__)
+#define TRACE_DUMP(path) \
+    trace_detail::registry::instance().dump(path)
+
+#else
+
+/// Tracing compiled out: `traced_mutex<M>` is `M` with a name argument that
+/// is ignored, and the macros leave only the wrapped expression.
+template<typename Mutex>
+class traced_mutex : public Mutex
+{
+public:
+
+    explicit constexpr
+    traced_mutex(const char*) noexcept
+    { }
+};
+
+#define TRACE_SCOPE(category, name) static_cast<void>(0)
+#define TRACE_WAIT(category, name, ...) (__VA_ARGS__)
+#define TRACE_INSTANT(category, name) static_cast<void>(0)
+#define TRACE_THREAD_NAME(...) static_cast<void>(0)
+#define TRACE_DUMP(path) static_cast<void>(0)
+
+#endif
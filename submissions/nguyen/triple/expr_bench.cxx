@@ -0,0 +1,213 @@
+/// Evaluates `out = a + b * s - c / t` over 10M triples three ways: one
+/// whole-array temporary per operator (what eager operators do), the
+/// expression templates from `triple_expr.hxx` and a hand-fused loop as the
+/// lower bound. Runs over both `std::vector<Triple<float>>` and
+/// `triple_soa<float>`.
+///
+/// Build with: g++ -std=c++20 -O3 -march=native expr_bench.cxx -o expr_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "triple.hxx"
+#include "triple_expr.hxx"
+#include "triple_soa.hxx"
+
+constexpr auto elements = std::size_t{ 10'000'000 };
+constexpr auto repeats  = 10;
+
+/// Expression templates also work on single triples at compile time.
+static_assert([]
+{
+    constexpr auto a = Triple<int>{1, 2, 3};
+    constexpr auto b = Triple<int>{4, 5, 6};
+    constexpr Triple<int> r = a + b * 2 - a / 1;
+    return r.x == 8 && r.y == 10 && r.z == 12;
+}());
+
+/// Best of `repeats` runs, in milliseconds.
+template <typename F>
+auto
+best_ms(F&& f)
+    -> double
+{
+    auto best = std::chrono::duration<double, std::milli>::max();
+    for (auto r = 0; r < repeats; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::invoke(f);
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start));
+    }
+    return best.count();
+}
+
+/// Eager whole-array operators, each returning a fresh array.
+namespace eager
+{
+    auto
+    add(const std::vector<Triple<float>>& a, const std::vector<Triple<float>>& b)
+        -> std::vector<Triple<float>>
+    {
+        auto out = std::vector<Triple<float>>(a.size());
+        for (auto i = std::size_t{ 0 }; i < a.size(); ++i)
+            out[i] = a[i].add(b[i]);
+        return out;
+    }
+
+    auto
+    subtract(const std::vector<Triple<float>>& a, const std::vector<Triple<float>>& b)
+        -> std::vector<Triple<float>>
+    {
+        auto out = std::vector<Triple<float>>(a.size());
+        for (auto i = std::size_t{ 0 }; i < a.size(); ++i)
+            out[i] = a[i].subtract(b[i]);
+        return out;
+    }
+
+    auto
+    multiply(const std::vector<Triple<float>>& a, float s)
+        -> std::vector<Triple<float>>
+    {
+        auto out = std::vector<Triple<float>>(a.size());
+        for (auto i = std::size_t{ 0 }; i < a.size(); ++i)
+            out[i] = a[i].multiply(a[i], s);
+        return out;
+    }
+
+    auto
+    divide(const std::vector<Triple<float>>& a, float s)
+        -> std::vector<Triple<float>>
+    {
+        auto out = std::vector<Triple<float>>(a.size());
+        for (auto i = std::size_t{ 0 }; i < a.size(); ++i)
+            out[i] = a[i].divide(a[i], s);
+        return out;
+    }
+}
+
+/// Within rounding: the fused versions may contract into FMAs where the
+/// eager version cannot.
+auto
+close(const Triple<float>& u, const Triple<float>& v)
+    -> bool
+{ return std::abs(u.x - v.x) <= 1e-3f && std::abs(u.y - v.y) <= 1e-3f && std::abs(u.z - v.z) <= 1e-3f; }
+
+auto
+print(const std::string& layout, const std::string& method, double ms, double baseline)
+    -> void
+{
+    std::cout << "| " << std::setw(6) << layout << " | " << std::setw(20) << method << " | "
+              << std::setw(9) << ms << " | " << std::setw(7) << baseline / ms << "x |" << std::endl;
+}
+
+auto main() -> int
+{
+    auto gen = std::mt19937{ 42 };
+    auto dist = std::uniform_real_distribution<float>{ -100.0f, 100.0f };
+    constexpr auto s = 1.5f;
+    constexpr auto t = 4.0f;
+
+    auto a = std::vector<Triple<float>>(elements);
+    auto b = std::vector<Triple<float>>(elements);
+    auto c = std::vector<Triple<float>>(elements);
+    for (auto i = std::size_t{ 0 }; i < elements; ++i)
+    {
+        a[i] = Triple<float>{dist(gen), dist(gen), dist(gen)};
+        b[i] = Triple<float>{dist(gen), dist(gen), dist(gen)};
+        c[i] = Triple<float>{dist(gen), dist(gen), dist(gen)};
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "out = a + b * s - c / t over " << elements << " triples, best of " << repeats << ".\n";
+    std::cout << "+--------+----------------------+-----------+----------+" << std::endl;
+    std::cout << "| Layout |        Method        |    ms     | Speedup  |" << std::endl;
+    std::cout << "+--------+----------------------+-----------+----------+" << std::endl;
+
+    auto expected = std::vector<Triple<float>>{};
+    {
+        auto out = std::vector<Triple<float>>{};
+        auto base = best_ms([&]() { out = eager::subtract(eager::add(a, eager::multiply(b, s)), eager::divide(c, t)); });
+        print("AoS", "eager temporaries", base, base);
+        expected = out;
+
+        auto et = best_ms([&]() { assign(out, a + b * s - c / t); });
+        print("AoS", "expression template", et, base);
+        auto same = std::ranges::equal(out, expected, close);
+
+        auto fused = best_ms([&]()
+        {
+            out.resize(elements);
+            for (auto i = std::size_t{ 0 }; i < elements; ++i)
+                out[i] = Triple<float>{a[i].x + b[i].x * s - c[i].x / t,
+                                       a[i].y + b[i].y * s - c[i].y / t,
+                                       a[i].z + b[i].z * s - c[i].z / t};
+        });
+        print("AoS", "hand-fused loop", fused, base);
+        std::cout << "+--------+----------------------+-----------+----------+" << std::endl;
+        if (!same)
+            std::cout << "AoS expression template result differs!" << std::endl;
+    }
+
+    {
+        auto sa = triple_soa<float>{};
+        auto sb = triple_soa<float>{};
+        auto sc = triple_soa<float>{};
+        for (auto i = std::size_t{ 0 }; i < elements; ++i)
+        {
+            sa.push_back(a[i]);
+            sb.push_back(b[i]);
+            sc.push_back(c[i]);
+        }
+
+        auto out = triple_soa<float>{};
+        auto base = best_ms([&]()
+        {
+            auto t1 = triple_soa<float>{};
+            auto t2 = triple_soa<float>{};
+            auto t3 = triple_soa<float>{};
+            multiply(sb, s, t1);
+            add(sa, t1, t2);
+            divide(sc, t, t3);
+            subtract(t2, t3, out);
+        });
+        print("SoA", "eager temporaries", base, base);
+
+        auto et = best_ms([&]() { assign(out, sa + sb * s - sc / t); });
+        print("SoA", "expression template", et, base);
+
+        auto diffs = std::size_t{ 0 };
+        for (auto i = std::size_t{ 0 }; i < elements; ++i)
+        {
+            if (!close(out[i], expected[i]))
+                ++diffs;
+        }
+
+        auto ox = out.x().data(), oy = out.y().data(), oz = out.z().data();
+        auto ax = sa.x().data(), ay = sa.y().data(), az = sa.z().data();
+        auto bx = sb.x().data(), by = sb.y().data(), bz = sb.z().data();
+        auto cx = sc.x().data(), cy = sc.y().data(), cz = sc.z().data();
+        auto fused = best_ms([&]()
+        {
+            for (auto i = std::size_t{ 0 }; i < elements; ++i)
+            {
+                ox[i] = ax[i] + bx[i] * s - cx[i] / t;
+                oy[i] = ay[i] + by[i] * s - cy[i] / t;
+                oz[i] = az[i] + bz[i] * s - cz[i] / t;
+            }
+        });
+        print("SoA", "hand-fused loop", fused, base);
+        std::cout << "+--------+----------------------+-----------+----------+" << std::endl;
+        if (diffs)
+            std::cout << "SoA expression template result differs in " << diffs << " elements!" << std::endl;
+    }
+
+    return 0;
+}
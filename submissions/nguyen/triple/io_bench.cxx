@@ -0,0 +1,123 @@
+/// Load throughput of a text file of `Triple<float>`s through
+/// `Triple::operator>>` (prompts discarded) against `load_text` with
+/// `std::from_chars` over a memory map on 1 to N threads, plus mapping the
+/// same triples from the packed binary format.
+///
+/// Build with: g++ -std=c++20 -O3 -march=native io_bench.cxx -o io_bench
+/// Run with:   ./io_bench [size in MB, default 1024] [scratch directory, default /tmp]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "triple.hxx"
+#include "triple_io.hxx"
+
+/// Seconds taken by one run of `f`; the file is in the page cache after
+/// generation, so this measures parsing rather than the disk.
+template <typename F>
+auto
+seconds(F&& f)
+    -> double
+{
+    auto start = std::chrono::steady_clock::now();
+    std::invoke(f);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+auto
+checksum(std::span<const Triple<float>> ts)
+    -> double
+{
+    auto sum = 0.0;
+    for (const auto& t : ts)
+        sum += static_cast<double>(t.x) + t.y + t.z;
+    return sum;
+}
+
+auto
+print(const std::string& method, double mb, double secs, double check)
+    -> void
+{
+    std::cout << "| " << std::setw(24) << method << " | " << std::setw(9) << secs << " | "
+              << std::setw(10) << mb / secs << " | " << std::setw(14) << check << " |" << std::endl;
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto target_mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024ull;
+    auto dir = std::filesystem::path{ argc > 2 ? argv[2] : "/tmp" };
+    auto text_path = (dir / "triples.txt").string();
+    auto binary_path = (dir / "triples.bin").string();
+
+    /// Lines average a little under 30 bytes.
+    auto count = target_mb * 1024 * 1024 / 30;
+    {
+        auto gen = std::mt19937{ 42 };
+        auto dist = std::uniform_real_distribution<float>{ -1000.0f, 1000.0f };
+        auto triples = std::vector<Triple<float>>(count);
+        for (auto& t : triples)
+            t = Triple<float>{dist(gen), dist(gen), dist(gen)};
+        save_text<float>(text_path, triples);
+        save_binary<float>(binary_path, triples);
+    }
+
+    auto mb = static_cast<double>(std::filesystem::file_size(text_path)) / (1024.0 * 1024.0);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << count << " triples, " << mb << " MB of text.\n";
+    std::cout << "+--------------------------+-----------+------------+----------------+" << std::endl;
+    std::cout << "|          Method          |  Seconds  | Text MB/s  |    Checksum    |" << std::endl;
+    std::cout << "+--------------------------+-----------+------------+----------------+" << std::endl;
+
+    {
+        auto triples = std::vector<Triple<float>>{};
+        auto secs = seconds([&]()
+        {
+            auto is = std::ifstream{ text_path };
+            auto* saved = std::cout.rdbuf(nullptr);     ///< Swallow the prompts
+            auto t = Triple<float>{};
+            while (is >> t)
+                triples.push_back(t);
+            std::cout.rdbuf(saved);
+            std::cout.clear();
+        });
+        print("Triple::operator>>", mb, secs, checksum(triples));
+    }
+
+    auto max_threads = std::max(std::thread::hardware_concurrency(), 2u);
+    for (auto thr_count { 1u }; thr_count <= max_threads; thr_count = thr_count < max_threads && thr_count * 2 > max_threads ? max_threads : thr_count * 2)
+    {
+        auto triples = std::vector<Triple<float>>{};
+        auto secs = seconds([&]() { triples = load_text<float>(text_path, thr_count); });
+        print("from_chars, " + std::to_string(thr_count) + " threads", mb, secs, checksum(triples));
+
+        if (thr_count == max_threads)
+            break;
+    }
+
+    {
+        auto check = 0.0;
+        auto secs = seconds([&]()
+        {
+            auto file = triple_file<float>{ binary_path };
+            check = checksum(file.triples());       ///< Touch every triple
+        });
+        print("binary mmap", mb, secs, check);
+    }
+
+    std::cout << "+--------------------------+-----------+------------+----------------+" << std::endl;
+
+    std::filesystem::remove(text_path);
+    std::filesystem::remove(binary_path);
+    return 0;
+}
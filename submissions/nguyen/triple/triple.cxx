@@ -9,59 +9,10 @@
 /// When the file is executing, there will be output at the end asking for some input which must be in number, and can be whole or decimal number
 
 #include <iostream>
-using namespace std;
-
-template <typename T>
-struct Triple 
-{
-    T x;
-    T y;
-    T z;
-   
-    constexpr auto
-    add(const Triple& o)
-        const noexcept
-        -> Triple
-    { return Triple{x + o.x, y + o.y, z + o.z}; }
 
-    constexpr auto
-    subtract(const Triple& o)
-        const noexcept
-        -> Triple
-    { return Triple{x - o.x, y - o.y, z - o.z}; }
+#include "triple.hxx"
 
-    constexpr auto
-    multiply(const Triple& o, const T scalar)
-        const noexcept
-        -> Triple
-    { return Triple{x*scalar, y*scalar, z*scalar}; }
-
-    constexpr auto
-    divide(const Triple& o, const T scalar)
-        const noexcept
-        -> Triple
-    { return Triple{x/scalar, y/scalar, z/scalar}; }
-    
-    friend auto
-    operator<< (std::ostream& os, const Triple& v)
-        -> std::ostream&
-    {
-        os << "(.x: " << v.x << ", .y: " << v.y << ", .z: " << v.z <<")";
-        return os; 
-    }
-
-    friend istream&
-    operator>> (std::istream& is, Triple& v)
-    {
-        std::cout << "Enter x ";
-        is >> v.x;
-        std::cout << "Enter y ";
-        is >> v.y;
-        std::cout << "Enter z ";
-        is >> v.z;
-        return is;
-    }
-};
+using namespace std;
 
 auto main() -> int 
 {
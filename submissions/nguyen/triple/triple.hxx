@@ -0,0 +1,79 @@
+/// Date: 11/01/23
+///
+/// Copyright: Copyright (c) 2023
+/// \file triple.hxx
+
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+template <typename T>
+struct Triple 
+{
+    T x;
+    T y;
+    T z;
+   
+    constexpr auto
+    add(const Triple& o)
+        const noexcept
+        -> Triple
+    { return Triple{x + o.x, y + o.y, z + o.z}; }
+
+    constexpr auto
+    subtract(const Triple& o)
+        const noexcept
+        -> Triple
+    { return Triple{x - o.x, y - o.y, z - o.z}; }
+
+    constexpr auto
+    multiply(const Triple& o, const T scalar)
+        const noexcept
+        -> Triple
+    { return Triple{x*scalar, y*scalar, z*scalar}; }
+
+    constexpr auto
+    divide(const Triple& o, const T scalar)
+        const noexcept
+        -> Triple
+    { return Triple{x/scalar, y/scalar, z/scalar}; }
+
+    constexpr auto
+    dot(const Triple& o)
+        const noexcept
+        -> T
+    { return x*o.x + y*o.y + z*o.z; }
+
+    constexpr auto
+    cross(const Triple& o)
+        const noexcept
+        -> Triple
+    { return Triple{y*o.z - z*o.y, z*o.x - x*o.z, x*o.y - y*o.x}; }
+
+    auto
+    norm()
+        const noexcept
+        -> T
+    { return static_cast<T>(std::sqrt(dot(*this))); }
+    
+    friend auto
+    operator<< (std::ostream& os, const Triple& v)
+        -> std::ostream&
+    {
+        os << "(.x: " << v.x << ", .y: " << v.y << ", .z: " << v.z <<")";
+        return os; 
+    }
+
+    friend std::istream&
+    operator>> (std::istream& is, Triple& v)
+    {
+        std::cout << "Enter x ";
+        is >> v.x;
+        std::cout << "Enter y ";
+        is >> v.y;
+        std::cout << "Enter z ";
+        is >> v.z;
+        return is;
+    }
+};
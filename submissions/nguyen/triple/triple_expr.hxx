@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "triple.hxx"
+#include "triple_soa.hxx"
+
+/// Expression templates for `Triple<T>` and arrays of them.
+///
+/// `+`, `-` between triples (or arrays of triples) and `*`, `/` by a scalar
+/// build a tree of small nodes instead of computing anything. The tree is
+/// evaluated element by element when it is converted to a `Triple<T>` or
+/// passed to `assign`, so `assign(out, a + b * s - c)` over arrays runs as
+/// one loop with no intermediate array and `Triple<T> r = a + b * s - c`
+/// computes each component once with no intermediate `Triple`.
+///
+/// Single `Triple`s are captured by value and broadcast against arrays, so
+/// `assign(out, points - origin)` subtracts `origin` from every element.
+/// Arrays (`std::vector<Triple<T>>` and `triple_soa<T>`) are captured by
+/// reference: an expression must not outlive the arrays it names, and
+/// temporary arrays are rejected at compile time.
+///
+/// Everything is `constexpr`, so scalar expressions can be evaluated at
+/// compile time.
+
+/// Every expression node has a `value_type` (the component type), a
+/// `scalar` flag (true when it contains no arrays), `size()` and
+/// `operator[]` returning the `Triple` at an index.
+template <typename E>
+concept triple_node = requires (const E& e, std::size_t i)
+{
+    typename E::value_type;
+    { E::scalar } -> std::convertible_to<bool>;
+    { e.size() } -> std::same_as<std::size_t>;
+    { e[i] } -> std::same_as<Triple<typename E::value_type>>;
+};
+
+/// Leaf holding a single `Triple` by value; broadcast against arrays.
+template <typename T>
+struct triple_value
+{
+    using value_type = T;
+    static constexpr bool scalar = true;
+
+    Triple<T> v;
+
+    constexpr auto
+    size()
+        const noexcept
+        -> std::size_t
+    { return 1; }
+
+    constexpr auto
+    operator[] (std::size_t)
+        const noexcept
+        -> Triple<T>
+    { return v; }
+};
+
+/// Leaf referring to an array-of-structs.
+template <typename T>
+struct triple_span
+{
+    using value_type = T;
+    static constexpr bool scalar = false;
+
+    std::span<const Triple<T>> s;
+
+    constexpr auto
+    size()
+        const noexcept
+        -> std::size_t
+    { return s.size(); }
+
+    constexpr auto
+    operator[] (std::size_t i)
+        const noexcept
+        -> Triple<T>
+    { return s[i]; }
+};
+
+/// Leaf referring to a structure-of-arrays.
+template <typename T>
+struct triple_soa_ref
+{
+    using value_type = T;
+    static constexpr bool scalar = false;
+
+    const T* x;
+    const T* y;
+    const T* z;
+    std::size_t n;
+
+    constexpr auto
+    size()
+        const noexcept
+        -> std::size_t
+    { return n; }
+
+    constexpr auto
+    operator[] (std::size_t i)
+        const noexcept
+        -> Triple<T>
+    { return Triple<T>{x[i], y[i], z[i]}; }
+};
+
+/// `l op r` for two triples, element-wise.
+template <typename Op, triple_node L, triple_node R>
+    requires std::same_as<typename L::value_type, typename R::value_type>
+struct triple_binary
+{
+    using value_type = typename L::value_type;
+    static constexpr bool scalar = L::scalar && R::scalar;
+
+    L l;
+    R r;
+
+    constexpr
+    triple_binary(L lhs, R rhs)
+        : l{ std::move(lhs) }
+        , r{ std::move(rhs) }
+    {
+        if constexpr (!L::scalar && !R::scalar)
+            if (l.size() != r.size())
+                throw std::length_error("Size Mismatch");
+    }
+
+    constexpr auto
+    size()
+        const noexcept
+        -> std::size_t
+    {
+        if constexpr (L::scalar)
+            return r.size();
+        else
+            return l.size();
+    }
+
+    constexpr auto
+    operator[] (std::size_t i)
+        const noexcept
+        -> Triple<value_type>
+    { return Op{}(l[L::scalar ? 0 : i], r[R::scalar ? 0 : i]); }
+
+    constexpr
+    operator Triple<value_type>()
+        const noexcept
+        requires scalar
+    { return (*this)[0]; }
+};
+
+/// `e op s` for a triple and a scalar.
+template <typename Op, triple_node E>
+struct triple_scaled
+{
+    using value_type = typename E::value_type;
+    static constexpr bool scalar = E::scalar;
+
+    E e;
+    value_type s;
+
+    constexpr auto
+    size()
+        const noexcept
+        -> std::size_t
+    { return e.size(); }
+
+    constexpr auto
+    operator[] (std::size_t i)
+        const noexcept
+        -> Triple<value_type>
+    { return Op{}(e[E::scalar ? 0 : i], s); }
+
+    constexpr
+    operator Triple<value_type>()
+        const noexcept
+        requires scalar
+    { return (*this)[0]; }
+};
+
+struct triple_plus
+{
+    template <typename T>
+    constexpr auto
+    operator() (const Triple<T>& a, const Triple<T>& b)
+        const noexcept
+        -> Triple<T>
+    { return a.add(b); }
+};
+
+struct triple_minus
+{
+    template <typename T>
+    constexpr auto
+    operator() (const Triple<T>& a, const Triple<T>& b)
+        const noexcept
+        -> Triple<T>
+    { return a.subtract(b); }
+};
+
+struct triple_times
+{
+    template <typename T>
+    constexpr auto
+    operator() (const Triple<T>& a, const T s)
+        const noexcept
+        -> Triple<T>
+    { return a.multiply(a, s); }
+};
+
+struct triple_divides
+{
+    template <typename T>
+    constexpr auto
+    operator() (const Triple<T>& a, const T s)
+        const noexcept
+        -> Triple<T>
+    { return a.divide(a, s); }
+};
+
+/// Turns an operand into an expression node.
+
+template <typename T>
+constexpr auto
+as_expr(const Triple<T>& v)
+    noexcept
+    -> triple_value<T>
+{ return triple_value<T>{v}; }
+
+template <typename T>
+constexpr auto
+as_expr(const std::vector<Triple<T>>& v)
+    noexcept
+    -> triple_span<T>
+{ return triple_span<T>{std::span<const Triple<T>>{v}}; }
+
+template <typename T>
+constexpr auto
+as_expr(const triple_soa<T>& v)
+    noexcept
+    -> triple_soa_ref<T>
+{ return triple_soa_ref<T>{v.x().data(), v.y().data(), v.z().data(), v.size()}; }
+
+template <typename T>
+auto as_expr(std::vector<Triple<T>>&&) -> void = delete;
+
+template <typename T>
+auto as_expr(triple_soa<T>&&) -> void = delete;
+
+template <triple_node E>
+constexpr auto
+as_expr(const E& e)
+    noexcept
+    -> E
+{ return e; }
+
+/// Anything `as_expr` accepts.
+template <typename X>
+concept triple_operand = requires (X&& x)
+{
+    { as_expr(std::forward<X>(x)) } -> triple_node;
+};
+
+template <typename X>
+using triple_node_of = decltype(as_expr(std::declval<X>()));
+
+/// Operators. Both sides must be triples, arrays of triples or nodes, so
+/// these never match unrelated types.
+template <triple_operand L, triple_operand R>
+constexpr auto
+operator+ (L&& l, R&& r)
+    -> triple_binary<triple_plus, triple_node_of<L>, triple_node_of<R>>
+{ return { as_expr(std::forward<L>(l)), as_expr(std::forward<R>(r)) }; }
+
+template <triple_operand L, triple_operand R>
+constexpr auto
+operator- (L&& l, R&& r)
+    -> triple_binary<triple_minus, triple_node_of<L>, triple_node_of<R>>
+{ return { as_expr(std::forward<L>(l)), as_expr(std::forward<R>(r)) }; }
+
+template <triple_operand X>
+constexpr auto
+operator* (X&& x, typename triple_node_of<X>::value_type s)
+    -> triple_scaled<triple_times, triple_node_of<X>>
+{ return { as_expr(std::forward<X>(x)), s }; }
+
+template <triple_operand X>
+constexpr auto
+operator* (typename triple_node_of<X>::value_type s, X&& x)
+    -> triple_scaled<triple_times, triple_node_of<X>>
+{ return { as_expr(std::forward<X>(x)), s }; }
+
+template <triple_operand X>
+constexpr auto
+operator/ (X&& x, typename triple_node_of<X>::value_type s)
+    -> triple_scaled<triple_divides, triple_node_of<X>>
+{ return { as_expr(std::forward<X>(x)), s }; }
+
+/// Evaluates a scalar expression.
+template <triple_node E>
+    requires E::scalar
+constexpr auto
+eval(const E& e)
+    noexcept
+    -> Triple<typename E::value_type>
+{ return e[0]; }
+
+template <triple_node E>
+    requires E::scalar
+auto
+operator<< (std::ostream& os, const E& e)
+    -> std::ostream&
+{ return os << eval(e); }
+
+/// Evaluates an array expression into `out` in a single pass. Element `i`
+/// of the result only reads element `i` of each array, so `out` may also
+/// appear in the expression.
+template <typename T, triple_node E>
+    requires (!E::scalar) && std::same_as<T, typename E::value_type>
+constexpr auto
+assign(std::vector<Triple<T>>& out, const E& e)
+    -> void
+{
+    auto n = e.size();
+    out.resize(n);
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        out[i] = e[i];
+}
+
+template <typename T, triple_node E>
+    requires (!E::scalar) && std::same_as<T, typename E::value_type>
+constexpr auto
+assign(triple_soa<T>& out, const E& e)
+    -> void
+{
+    auto n = e.size();
+    out.resize(n);
+    auto ox = out.x().data(), oy = out.y().data(), oz = out.z().data();
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+    {
+        auto v = e[i];
+        ox[i] = v.x;
+        oy[i] = v.y;
+        oz[i] = v.z;
+    }
+}
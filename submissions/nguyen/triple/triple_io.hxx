@@ -0,0 +1,376 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "triple.hxx"
+
+/// Bulk I/O for arrays of `Triple<T>`, as a replacement for the interactive
+/// `operator>>`.
+///
+/// Text files hold one triple per line, components separated by spaces or
+/// tabs. `load_text` maps the file, cuts it into one chunk per thread at
+/// line boundaries and parses every chunk with `std::from_chars` (no locale,
+/// no stream state, no copies) straight into its slice of the result.
+///
+/// Binary files are a small header followed by the packed `Triple<T>`
+/// array exactly as it sits in memory, so `triple_file` can map one and hand
+/// out a `std::span` over the triples without reading or copying anything.
+
+/// Read-only memory map of a whole file.
+class mapped_file
+{
+public:
+
+    explicit
+    mapped_file(const std::string& path)
+    {
+        auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), path);
+
+        struct stat st;
+        if (::fstat(fd, &st) < 0)
+        {
+            auto err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), path);
+        }
+
+        m_size = static_cast<std::size_t>(st.st_size);
+        if (m_size > 0)
+        {
+            auto p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                auto err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), path);
+            }
+            m_data = static_cast<const char*>(p);
+            ::madvise(p, m_size, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    auto operator= (const mapped_file&) -> mapped_file& = delete;
+
+    mapped_file(mapped_file&& o) noexcept
+        : m_data{ std::exchange(o.m_data, nullptr) }
+        , m_size{ std::exchange(o.m_size, 0) }
+    { }
+
+    ~mapped_file() noexcept
+    {
+        if (m_data)
+            ::munmap(const_cast<char*>(m_data), m_size);
+    }
+
+    auto
+    data()
+        const noexcept
+        -> const char*
+    { return m_data; }
+
+    auto
+    size()
+        const noexcept
+        -> std::size_t
+    { return m_size; }
+
+    auto
+    view()
+        const noexcept
+        -> std::string_view
+    { return std::string_view{ m_data, m_size }; }
+
+private:
+
+    const char* m_data { nullptr };
+    std::size_t m_size { 0 };
+};
+
+namespace triple_io_detail
+{
+    inline auto
+    is_blank(char c)
+        noexcept
+        -> bool
+    { return c == ' ' || c == '\t' || c == '\r'; }
+
+    /// Cuts `text` into at most `parts` chunks, each ending just after a
+    /// newline (or at the end of the text).
+    inline auto
+    split_lines(std::string_view text, std::size_t parts)
+        -> std::vector<std::string_view>
+    {
+        auto chunks = std::vector<std::string_view>{};
+        auto begin = std::size_t{ 0 };
+        for (auto p = std::size_t{ 1 }; p <= parts && begin < text.size(); ++p)
+        {
+            auto end = p == parts ? text.size() : std::max(begin, text.size() * p / parts);
+            if (end < text.size())
+            {
+                auto nl = text.find('\n', end);
+                end = nl == std::string_view::npos ? text.size() : nl + 1;
+            }
+            chunks.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+        return chunks;
+    }
+
+    /// Lines containing something other than blanks.
+    inline auto
+    count_lines(std::string_view chunk)
+        noexcept
+        -> std::size_t
+    {
+        auto lines = std::size_t{ 0 };
+        auto blank = true;
+        for (auto c : chunk)
+        {
+            if (c == '\n')
+            {
+                lines += !blank;
+                blank = true;
+            }
+            else if (!is_blank(c))
+                blank = false;
+        }
+        return lines + !blank;
+    }
+
+    template <typename T>
+    auto
+    parse_component(const char*& p, const char* end)
+        -> T
+    {
+        while (p != end && is_blank(*p))
+            ++p;
+        /// `from_chars` rejects a leading '+', which `operator>>` accepts.
+        if (p != end && *p == '+')
+            ++p;
+
+        auto value = T{};
+        auto [next, ec] = std::from_chars(p, end, value);
+        if (ec != std::errc{})
+            throw std::invalid_argument("Malformed Triple");
+        p = next;
+        return value;
+    }
+
+    /// Parses every non-blank line of `chunk` into `out`.
+    template <typename T>
+    auto
+    parse_chunk(std::string_view chunk, Triple<T>* out)
+        -> void
+    {
+        auto p = chunk.data();
+        auto end = p + chunk.size();
+        while (p != end)
+        {
+            while (p != end && (is_blank(*p) || *p == '\n'))
+                ++p;
+            if (p == end)
+                break;
+
+            out->x = parse_component<T>(p, end);
+            out->y = parse_component<T>(p, end);
+            out->z = parse_component<T>(p, end);
+            ++out;
+
+            while (p != end && is_blank(*p))
+                ++p;
+            if (p != end && *p != '\n')
+                throw std::invalid_argument("Malformed Triple");
+        }
+    }
+
+    /// 'TRPL' in little-endian order.
+    inline constexpr std::uint32_t magic = 0x4c505254;
+    inline constexpr std::uint32_t version = 1;
+
+    /// Sized so the triples that follow stay aligned for any arithmetic `T`.
+    struct header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t component_size;
+        std::uint32_t is_floating;
+        std::uint64_t count;
+        std::uint64_t reserved;
+    };
+
+    static_assert(sizeof(header) == 32);
+}
+
+/// Parses text triples with `threads` workers.
+template <typename T>
+    requires std::is_arithmetic_v<T>
+auto
+parse_text(std::string_view text, unsigned threads = std::thread::hardware_concurrency())
+    -> std::vector<Triple<T>>
+{
+    using namespace triple_io_detail;
+
+    auto chunks = split_lines(text, std::max(threads, 1u));
+
+    /// First pass counts lines so each chunk knows where its triples go.
+    auto offsets = std::vector<std::size_t>(chunks.size() + 1, 0);
+    auto errors = std::vector<std::exception_ptr>(chunks.size());
+    auto result = std::vector<Triple<T>>{};
+
+    auto run = [&](auto&& work)
+    {
+        auto pool = std::vector<std::thread>();
+        pool.reserve(chunks.size());
+        for (auto i = std::size_t{ 0 }; i < chunks.size(); ++i)
+            pool.emplace_back([&work, &errors, i]()
+            {
+                try { work(i); }
+                catch (...) { errors[i] = std::current_exception(); }
+            });
+        for (auto& th : pool)
+            th.join();
+        for (auto& e : errors)
+            if (e)
+                std::rethrow_exception(e);
+    };
+
+    run([&](std::size_t i) { offsets[i + 1] = count_lines(chunks[i]); });
+    for (auto i = std::size_t{ 0 }; i < chunks.size(); ++i)
+        offsets[i + 1] += offsets[i];
+
+    result.resize(offsets.back());
+    run([&](std::size_t i) { parse_chunk<T>(chunks[i], result.data() + offsets[i]); });
+    return result;
+}
+
+template <typename T>
+    requires std::is_arithmetic_v<T>
+auto
+load_text(const std::string& path, unsigned threads = std::thread::hardware_concurrency())
+    -> std::vector<Triple<T>>
+{
+    auto file = mapped_file{ path };
+    return parse_text<T>(file.view(), threads);
+}
+
+/// Writes triples one per line in the format `load_text` reads.
+template <typename T>
+auto
+save_text(const std::string& path, std::span<const Triple<T>> triples)
+    -> void
+{
+    auto os = std::ofstream{ path, std::ios::binary };
+    if (!os)
+        throw std::system_error(errno, std::generic_category(), path);
+
+    auto line = std::string{};
+    char buf[64];
+    for (const auto& t : triples)
+    {
+        line.clear();
+        for (auto v : { t.x, t.y, t.z })
+        {
+            auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+            line.append(buf, end);
+            line.push_back(' ');
+        }
+        line.back() = '\n';
+        os.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+}
+
+/// Writes the packed binary format.
+template <typename T>
+    requires std::is_arithmetic_v<T>
+auto
+save_binary(const std::string& path, std::span<const Triple<T>> triples)
+    -> void
+{
+    using namespace triple_io_detail;
+
+    auto os = std::ofstream{ path, std::ios::binary };
+    if (!os)
+        throw std::system_error(errno, std::generic_category(), path);
+
+    auto h = header{ magic, version, sizeof(T), std::is_floating_point_v<T>, triples.size(), 0 };
+    os.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    os.write(reinterpret_cast<const char*>(triples.data()), static_cast<std::streamsize>(triples.size_bytes()));
+}
+
+/// Zero-copy view of a binary triple file. The triples are read straight
+/// from the page cache on first touch.
+template <typename T>
+    requires std::is_arithmetic_v<T> && std::is_trivially_copyable_v<Triple<T>>
+class triple_file
+{
+public:
+
+    explicit
+    triple_file(const std::string& path)
+        : m_file{ path }
+    {
+        using namespace triple_io_detail;
+
+        auto h = header{};
+        if (m_file.size() < sizeof(h))
+            throw std::runtime_error("Truncated Triple File");
+        std::memcpy(&h, m_file.data(), sizeof(h));
+
+        if (h.magic != magic || h.version != version)
+            throw std::runtime_error("Not A Triple File");
+        if (h.component_size != sizeof(T) || h.is_floating != std::is_floating_point_v<T>)
+            throw std::runtime_error("Component Type Mismatch");
+        if ((m_file.size() - sizeof(h)) / sizeof(Triple<T>) < h.count)
+            throw std::runtime_error("Truncated Triple File");
+
+        m_triples = std::span<const Triple<T>>{ reinterpret_cast<const Triple<T>*>(m_file.data() + sizeof(h)), h.count };
+    }
+
+    auto
+    triples()
+        const noexcept
+        -> std::span<const Triple<T>>
+    { return m_triples; }
+
+    auto
+    size()
+        const noexcept
+        -> std::size_t
+    { return m_triples.size(); }
+
+    auto
+    operator[] (std::size_t i)
+        const noexcept
+        -> const Triple<T>&
+    { return m_triples[i]; }
+
+private:
+
+    mapped_file m_file;
+    std::span<const Triple<T>> m_triples;
+};
@@ -0,0 +1,426 @@
+#pragma once
+
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "triple.hxx"
+
+/// Structure-of-arrays container of `Triple<T>`.
+///
+/// The x, y and z components live in three separate contiguous arrays, so a
+/// bulk operation streams through each component with unit stride and the
+/// compiler can fill every SIMD lane with the same component of consecutive
+/// triples. Element access goes through a `reference` proxy that keeps the
+/// `Triple` API (`.x`, `.y`, `.z`, `add`, `subtract`, ...), so code written
+/// against a single `Triple` still works on an element of the container.
+///
+/// The bulk operations (`add`, `subtract`, `multiply`, `divide`, `dot`,
+/// `cross`, `norm`) are free functions below. They are plain index loops
+/// over the component arrays; build with `-O3 -march=native` to have them
+/// vectorised for the host.
+template <typename T>
+class triple_soa
+{
+public:
+
+    using value_type = Triple<T>;
+    using size_type  = std::size_t;
+
+    /// Proxy for one element. Reads convert to a `Triple<T>`, writes go
+    /// straight to the component arrays.
+    struct reference
+    {
+        T& x;
+        T& y;
+        T& z;
+
+        constexpr
+        operator Triple<T>()
+            const noexcept
+        { return Triple<T>{x, y, z}; }
+
+        constexpr auto
+        operator= (const Triple<T>& v)
+            const noexcept
+            -> const reference&
+        {
+            x = v.x;
+            y = v.y;
+            z = v.z;
+            return *this;
+        }
+
+        constexpr auto
+        operator= (const reference& o)
+            const noexcept
+            -> const reference&
+        { return *this = Triple<T>(o); }
+
+        constexpr auto
+        add(const Triple<T>& o)
+            const noexcept
+            -> Triple<T>
+        { return Triple<T>(*this).add(o); }
+
+        constexpr auto
+        subtract(const Triple<T>& o)
+            const noexcept
+            -> Triple<T>
+        { return Triple<T>(*this).subtract(o); }
+
+        constexpr auto
+        multiply(const Triple<T>& o, const T scalar)
+            const noexcept
+            -> Triple<T>
+        { return Triple<T>(*this).multiply(o, scalar); }
+
+        constexpr auto
+        divide(const Triple<T>& o, const T scalar)
+            const noexcept
+            -> Triple<T>
+        { return Triple<T>(*this).divide(o, scalar); }
+
+        constexpr auto
+        dot(const Triple<T>& o)
+            const noexcept
+            -> T
+        { return Triple<T>(*this).dot(o); }
+
+        constexpr auto
+        cross(const Triple<T>& o)
+            const noexcept
+            -> Triple<T>
+        { return Triple<T>(*this).cross(o); }
+
+        auto
+        norm()
+            const noexcept
+            -> T
+        { return Triple<T>(*this).norm(); }
+
+        friend auto
+        operator<< (std::ostream& os, const reference& r)
+            -> std::ostream&
+        { return os << Triple<T>(r); }
+    };
+
+    /// Random access iterator yielding `reference` (or `Triple<T>` by value
+    /// when `Const`).
+    template <bool Const>
+    class basic_iterator
+    {
+    public:
+
+        using container         = std::conditional_t<Const, const triple_soa, triple_soa>;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = Triple<T>;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::conditional_t<Const, Triple<T>, typename triple_soa::reference>;
+
+        constexpr basic_iterator() noexcept = default;
+
+        constexpr
+        basic_iterator(container* c, size_type i) noexcept
+            : m_c{ c }
+            , m_i{ i }
+        { }
+
+        constexpr auto
+        operator* ()
+            const noexcept
+            -> reference
+        { return (*m_c)[m_i]; }
+
+        constexpr auto
+        operator[] (difference_type n)
+            const noexcept
+            -> reference
+        { return (*m_c)[m_i + n]; }
+
+        constexpr auto operator++ () noexcept -> basic_iterator& { ++m_i; return *this; }
+        constexpr auto operator-- () noexcept -> basic_iterator& { --m_i; return *this; }
+        constexpr auto operator++ (int) noexcept -> basic_iterator { auto t = *this; ++m_i; return t; }
+        constexpr auto operator-- (int) noexcept -> basic_iterator { auto t = *this; --m_i; return t; }
+        constexpr auto operator+= (difference_type n) noexcept -> basic_iterator& { m_i += n; return *this; }
+        constexpr auto operator-= (difference_type n) noexcept -> basic_iterator& { m_i -= n; return *this; }
+
+        friend constexpr auto
+        operator+ (basic_iterator it, difference_type n) noexcept -> basic_iterator
+        { return it += n; }
+
+        friend constexpr auto
+        operator+ (difference_type n, basic_iterator it) noexcept -> basic_iterator
+        { return it += n; }
+
+        friend constexpr auto
+        operator- (basic_iterator it, difference_type n) noexcept -> basic_iterator
+        { return it -= n; }
+
+        friend constexpr auto
+        operator- (const basic_iterator& a, const basic_iterator& b) noexcept -> difference_type
+        { return static_cast<difference_type>(a.m_i) - static_cast<difference_type>(b.m_i); }
+
+        friend constexpr auto
+        operator== (const basic_iterator& a, const basic_iterator& b) noexcept -> bool
+        { return a.m_i == b.m_i; }
+
+        friend constexpr auto
+        operator<=> (const basic_iterator& a, const basic_iterator& b) noexcept
+        { return a.m_i <=> b.m_i; }
+
+    private:
+
+        container* m_c { nullptr };
+        size_type m_i { 0 };
+    };
+
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    triple_soa() = default;
+
+    constexpr explicit
+    triple_soa(size_type n)
+        : m_x(n), m_y(n), m_z(n)
+    { }
+
+    constexpr
+    triple_soa(std::initializer_list<Triple<T>> init)
+    {
+        reserve(init.size());
+        for (const auto& v : init)
+            push_back(v);
+    }
+
+    constexpr auto
+    size()
+        const noexcept
+        -> size_type
+    { return m_x.size(); }
+
+    constexpr auto
+    empty()
+        const noexcept
+        -> bool
+    { return m_x.empty(); }
+
+    constexpr auto
+    reserve(size_type n)
+        -> void
+    {
+        m_x.reserve(n);
+        m_y.reserve(n);
+        m_z.reserve(n);
+    }
+
+    constexpr auto
+    resize(size_type n)
+        -> void
+    {
+        m_x.resize(n);
+        m_y.resize(n);
+        m_z.resize(n);
+    }
+
+    constexpr auto
+    push_back(const Triple<T>& v)
+        -> void
+    {
+        m_x.push_back(v.x);
+        m_y.push_back(v.y);
+        m_z.push_back(v.z);
+    }
+
+    constexpr auto
+    operator[] (size_type i)
+        noexcept
+        -> reference
+    { return reference{m_x[i], m_y[i], m_z[i]}; }
+
+    constexpr auto
+    operator[] (size_type i)
+        const noexcept
+        -> Triple<T>
+    { return Triple<T>{m_x[i], m_y[i], m_z[i]}; }
+
+    constexpr auto begin() noexcept -> iterator { return iterator{ this, 0 }; }
+    constexpr auto end() noexcept -> iterator { return iterator{ this, size() }; }
+    constexpr auto begin() const noexcept -> const_iterator { return const_iterator{ this, 0 }; }
+    constexpr auto end() const noexcept -> const_iterator { return const_iterator{ this, size() }; }
+
+    /// Component arrays.
+    constexpr auto x() noexcept -> std::span<T> { return m_x; }
+    constexpr auto y() noexcept -> std::span<T> { return m_y; }
+    constexpr auto z() noexcept -> std::span<T> { return m_z; }
+    constexpr auto x() const noexcept -> std::span<const T> { return m_x; }
+    constexpr auto y() const noexcept -> std::span<const T> { return m_y; }
+    constexpr auto z() const noexcept -> std::span<const T> { return m_z; }
+
+private:
+
+    std::vector<T> m_x;
+    std::vector<T> m_y;
+    std::vector<T> m_z;
+};
+
+/// Bulk operations. `out` is resized to match the inputs and may be one of
+/// them, in which case the operation happens in place. Each output component
+/// gets its own loop so every loop reads and writes only a few streams,
+/// which keeps the compiler's runtime alias checks cheap enough to
+/// vectorise. Mismatched input sizes throw `std::length_error`.
+
+namespace soa_detail
+{
+    template <typename T>
+    auto
+    check(const triple_soa<T>& a, const triple_soa<T>& b)
+        -> std::size_t
+    {
+        if (a.size() != b.size())
+            throw std::length_error("Size Mismatch");
+        return a.size();
+    }
+}
+
+template <typename T>
+auto
+add(const triple_soa<T>& a, const triple_soa<T>& b, triple_soa<T>& out)
+    -> void
+{
+    auto n = soa_detail::check(a, b);
+    out.resize(n);
+    auto ax = a.x().data(), ay = a.y().data(), az = a.z().data();
+    auto bx = b.x().data(), by = b.y().data(), bz = b.z().data();
+    auto ox = out.x().data(), oy = out.y().data(), oz = out.z().data();
+
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        ox[i] = ax[i] + bx[i];
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oy[i] = ay[i] + by[i];
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oz[i] = az[i] + bz[i];
+}
+
+template <typename T>
+auto
+subtract(const triple_soa<T>& a, const triple_soa<T>& b, triple_soa<T>& out)
+    -> void
+{
+    auto n = soa_detail::check(a, b);
+    out.resize(n);
+    auto ax = a.x().data(), ay = a.y().data(), az = a.z().data();
+    auto bx = b.x().data(), by = b.y().data(), bz = b.z().data();
+    auto ox = out.x().data(), oy = out.y().data(), oz = out.z().data();
+
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        ox[i] = ax[i] - bx[i];
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oy[i] = ay[i] - by[i];
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oz[i] = az[i] - bz[i];
+}
+
+template <typename T>
+auto
+multiply(const triple_soa<T>& a, const T scalar, triple_soa<T>& out)
+    -> void
+{
+    auto n = a.size();
+    out.resize(n);
+    auto ax = a.x().data(), ay = a.y().data(), az = a.z().data();
+    auto ox = out.x().data(), oy = out.y().data(), oz = out.z().data();
+
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        ox[i] = ax[i] * scalar;
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oy[i] = ay[i] * scalar;
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oz[i] = az[i] * scalar;
+}
+
+template <typename T>
+auto
+divide(const triple_soa<T>& a, const T scalar, triple_soa<T>& out)
+    -> void
+{
+    auto n = a.size();
+    out.resize(n);
+    auto ax = a.x().data(), ay = a.y().data(), az = a.z().data();
+    auto ox = out.x().data(), oy = out.y().data(), oz = out.z().data();
+
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        ox[i] = ax[i] / scalar;
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oy[i] = ay[i] / scalar;
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oz[i] = az[i] / scalar;
+}
+
+template <typename T>
+auto
+dot(const triple_soa<T>& a, const triple_soa<T>& b, std::vector<T>& out)
+    -> void
+{
+    auto n = soa_detail::check(a, b);
+    out.resize(n);
+    auto ax = a.x().data(), ay = a.y().data(), az = a.z().data();
+    auto bx = b.x().data(), by = b.y().data(), bz = b.z().data();
+    auto o = out.data();
+
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        o[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+}
+
+/// Each output component reads two components of both inputs, so the
+/// results go to a scratch container first when `out` aliases an input.
+template <typename T>
+auto
+cross(const triple_soa<T>& a, const triple_soa<T>& b, triple_soa<T>& out)
+    -> void
+{
+    auto n = soa_detail::check(a, b);
+    if (&out == &a || &out == &b)
+    {
+        auto tmp = triple_soa<T>{};
+        cross(a, b, tmp);
+        out = std::move(tmp);
+        return;
+    }
+
+    out.resize(n);
+    auto ax = a.x().data(), ay = a.y().data(), az = a.z().data();
+    auto bx = b.x().data(), by = b.y().data(), bz = b.z().data();
+    auto ox = out.x().data(), oy = out.y().data(), oz = out.z().data();
+
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        ox[i] = ay[i] * bz[i] - az[i] * by[i];
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oy[i] = az[i] * bx[i] - ax[i] * bz[i];
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        oz[i] = ax[i] * by[i] - ay[i] * bx[i];
+}
+
+/// `std::sqrt` only vectorises without `errno` updates, i.e. with
+/// `-fno-math-errno` (implied by `-ffast-math`).
+template <typename T>
+auto
+norm(const triple_soa<T>& a, std::vector<T>& out)
+    -> void
+{
+    auto n = a.size();
+    out.resize(n);
+    auto ax = a.x().data(), ay = a.y().data(), az = a.z().data();
+    auto o = out.data();
+
+    for (auto i = std::size_t{ 0 }; i < n; ++i)
+        o[i] = static_cast<T>(std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]));
+}